@@ -1,68 +1,48 @@
 #pragma once
 
-#include "Grid.hpp"
-#include <vector>
-#include <queue>
-#include <optional>
-#include <limits>
+#include "SearchRunner.hpp"
 
-// Runner za A* algoritem
-class AStarRunner {
-public:
-    explicit AStarRunner(const Grid& grid);
-
-    // izvede en korak algoritma
-    bool step();
-
-    bool isFinished() const;
-    bool hasPath()   const;
+// A*: min-kopica po f = g + h, Manhattan hevristika, cena koraka je teren
+using AStarSearch = SearchRunner<HeapOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
+extern template class SearchRunner<HeapOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
 
-    bool isOpen(int gx, int gy) const;
-    bool isClosed(int gx, int gy) const;
-    bool isInPath(int gx, int gy) const;
+// A* z bucket queue po f; pri enakem f LIFO (večji g najprej)
+using AStarBucketSearch = SearchRunner<BucketOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
+extern template class SearchRunner<BucketOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
 
-    int getGScore(int gx, int gy) const;
+// A* z radix heap po f (za utežene mreže)
+using AStarRadixSearch = SearchRunner<RadixHeapOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
+extern template class SearchRunner<RadixHeapOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
 
-    // statistika za primerjavo algoritmov
-    int getVisitedCount() const { return m_visitedCount; }
-    int getOpenMaxSize()  const { return m_openMaxSize;  }
-    int getPathLength()   const { return m_pathLength;   }
-
-private:
-    const Grid* m_grid = nullptr;
-    int m_rows = 0;
-    int m_cols = 0;
-
-    sf::Vector2i m_start{};
-    sf::Vector2i m_end{};
+// Runner za A* algoritem
+class AStarRunner : public AStarSearch {
+public:
+    using AStarSearch::AStarSearch;
+};
 
-    std::vector<std::vector<bool>> m_inOpen;
-    std::vector<std::vector<bool>> m_inClosed;
-    std::vector<std::vector<std::optional<sf::Vector2i>>> m_parent;
-    std::vector<std::vector<bool>> m_inPath;
-    std::vector<std::vector<int>>  m_gScore;
+class AStarBucketRunner : public AStarBucketSearch {
+public:
+    using AStarBucketSearch::AStarBucketSearch;
+};
 
-    static constexpr int INF = std::numeric_limits<int>::max();
+class AStarRadixRunner : public AStarRadixSearch {
+public:
+    using AStarRadixSearch::AStarRadixSearch;
+};
 
-    // element priority queue
-    using PQEntry = std::pair<int, sf::Vector2i>;
-    struct PQCompare {
-        bool operator()(const PQEntry& a, const PQEntry& b) const {
-            return a.first > b.first; // manjši fScore ima prednost (min-heap)
-        }
-    };
-    std::priority_queue<PQEntry, std::vector<PQEntry>, PQCompare> m_openPQ;
+// A* po 8-sosedski mreži z oktilno hevristiko (enote kot Dijkstra8Runner)
+using AStar8Search = SearchRunner<HeapOpenList64, Neighbors8, OctileTerrainCost<Octile10>, OctileHeuristic<Octile10>>;
+extern template class SearchRunner<HeapOpenList64, Neighbors8, OctileTerrainCost<Octile10>, OctileHeuristic<Octile10>>;
 
-    bool m_finished = false;
-    bool m_pathFound = false;
+using AStar8ExactSearch = SearchRunner<HeapOpenList64, Neighbors8, OctileTerrainCost<OctileExact>, OctileHeuristic<OctileExact>>;
+extern template class SearchRunner<HeapOpenList64, Neighbors8, OctileTerrainCost<OctileExact>, OctileHeuristic<OctileExact>>;
 
-    // števci za HUD
-    int m_visitedCount = 0;
-    int m_openMaxSize  = 0;
-    int m_pathLength   = 0;
+class AStar8Runner : public AStar8Search {
+public:
+    using AStar8Search::AStar8Search;
+};
 
-    bool inBounds(int gx, int gy) const;
-    void pushOpen(const sf::Vector2i& pos, int fScore);
-    void buildPath();
-    int heuristic(const sf::Vector2i& a, const sf::Vector2i& b) const;
+class AStar8ExactRunner : public AStar8ExactSearch {
+public:
+    using AStar8ExactSearch::AStar8ExactSearch;
 };
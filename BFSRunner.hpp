@@ -1,55 +1,23 @@
 #pragma once
 
-#include "Grid.hpp"
-#include <vector>
-#include <queue>
-#include <optional>
+#include "SearchRunner.hpp"
+
+// BFS: FIFO vrsta, vsak korak stane 1, brez hevristike
+using BFSSearch = SearchRunner<FifoOpenList, Neighbors4, UnitCost, ZeroHeuristic>;
+extern template class SearchRunner<FifoOpenList, Neighbors4, UnitCost, ZeroHeuristic>;
 
 // Runner za BFS, ki teče po korakih (primerno za animacijo)
-class BFSRunner {
+class BFSRunner : public BFSSearch {
 public:
-    explicit BFSRunner(const Grid& grid);
-
-    // izvede en korak BFS; vrne true, ko je algoritem končan
-    bool step();
-
-    bool isFinished() const;
-    bool hasPath()   const;
-
-    bool isOpen(int gx, int gy) const;
-    bool isClosed(int gx, int gy) const;
-    bool isInPath(int gx, int gy) const;
-
-    // statistika za HUD
-    int getVisitedCount() const { return m_visitedCount; }
-    int getOpenMaxSize()  const { return m_openMaxSize; }
-    int getPathLength()   const { return m_pathLength; }
-
-private:
-    const Grid* m_grid = nullptr;
-    int m_rows = 0;
-    int m_cols = 0;
-
-    sf::Vector2i m_start{};
-    sf::Vector2i m_end{};
-
-    std::vector<std::vector<bool>> m_visited;
-    std::vector<std::vector<bool>> m_inOpen;
-    std::vector<std::vector<bool>> m_inClosed;
-    std::vector<std::vector<std::optional<sf::Vector2i>>> m_parent;
-    std::vector<std::vector<bool>> m_inPath;
-
-    // FIFO vrsta za BFS
-    std::queue<sf::Vector2i> m_queue;
-
-    bool m_finished = false;
-    bool m_pathFound = false;
+    using BFSSearch::BFSSearch;
+};
 
-    // osnovna statistika BFS
-    int m_visitedCount = 0;
-    int m_openMaxSize  = 0;
-    int m_pathLength   = 0;
+// BFS po 8-sosedski mreži: vsak premik (tudi diagonalni) stane 1, pravilo za
+// vogale se poda konstruktorju (privzeto CornerCutting::Never)
+using BFS8Search = SearchRunner<FifoOpenList, Neighbors8, UnitCost, ZeroHeuristic>;
+extern template class SearchRunner<FifoOpenList, Neighbors8, UnitCost, ZeroHeuristic>;
 
-    bool inBounds(int gx, int gy) const;
-    void buildPath();  // sledenje parentov nazaj do starta
+class BFS8Runner : public BFS8Search {
+public:
+    using BFS8Search::BFS8Search;
 };
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Grid.hpp"
+#include "ThreadPool.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+// ena poizvedba poti in njen rezultat
+struct PathQuery {
+    sf::Vector2i start;
+    sf::Vector2i goal;
+};
+
+struct PathResult {
+    bool found = false;
+    std::int64_t cost = -1; // getPathCost() runnerja, -1 če poti ni
+    int visited = 0;   // razširjena vozlišča
+    std::vector<sf::Vector2i> path;
+};
+
+// Paketno iskanje poti: veliko neodvisnih poizvedb na isti (nespremenjeni)
+// mreži porazdeli po niteh bazena. Vsaka nit ima svoj runner, ki se med
+// poizvedbami samo ponastavi z reset(), zato v vročem delu ni alokacij razen
+// same poti. Runner je kateri koli razred z vmesnikom SearchRunner
+// (konstruktor iz mreže, reset(start, goal), step(), ...); dodatni argumenti
+// konstruktorja se shranijo in podajo vsakemu runnerju (npr. skupna tabela
+// skokov za JPS+).
+//
+// Rezultati so v istem vrstnem redu kot poizvedbe in so enaki, kot če bi vsako
+// poizvedbo pognali posebej. Mreže se med run() ne sme spreminjati.
+template <class Runner>
+class BatchPathfinder {
+public:
+    template <class... RunnerArgs>
+    BatchPathfinder(const Grid& grid, ThreadPool& pool, RunnerArgs... runnerArgs)
+        : m_grid(&grid),
+          m_pool(&pool),
+          m_runners(pool.size()),
+          m_makeRunner([&grid, runnerArgs...] {
+              return std::make_unique<Runner>(grid, runnerArgs...);
+          }) {}
+
+    std::vector<PathResult> run(std::span<const PathQuery> queries) {
+        std::vector<PathResult> results(queries.size());
+        // lene indekse mreže (komponente, maske sosedov) zgradimo pred niti,
+        // da jih te samo berejo
+        if constexpr (requires { Runner::prepareGrid(*m_grid); })
+            Runner::prepareGrid(*m_grid);
+        else
+            m_grid->refreshComponents();
+        m_pool->parallelFor(static_cast<int>(queries.size()), [&](int worker, int i) {
+            // nedosegljiv cilj zavrnemo brez runnerja (results[i] ostane "ni poti")
+            if (!m_grid->connected(queries[i].start, queries[i].goal))
+                return;
+
+            // runner nastane ob prvi poizvedbi niti, ki ga potrebuje
+            auto& runner = m_runners[worker];
+            if (!runner)
+                runner = m_makeRunner();
+
+            runner->reset(queries[i].start, queries[i].goal);
+            while (!runner->step()) {}
+
+            PathResult& r = results[i];
+            r.found = runner->hasPath();
+            r.cost = runner->getPathCost();
+            r.visited = runner->getVisitedCount();
+            r.path = runner->getPath();
+        });
+        return results;
+    }
+
+private:
+    const Grid* m_grid = nullptr;
+    ThreadPool* m_pool = nullptr;
+    std::vector<std::unique_ptr<Runner>> m_runners; // en runner na nit bazena
+    std::function<std::unique_ptr<Runner>()> m_makeRunner;
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Grid.hpp"
+#include "BatchPathfinder.hpp"
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// Vrste map, na katerih merimo runnerje brez okna
+enum class MapKind {
+    Open,   // prazna mreža
+    Maze,   // Grid::generateMaze()
+    Random  // naključni zidovi z dano gostoto
+};
+
+inline const char* mapKindName(MapKind kind) {
+    switch (kind) {
+        case MapKind::Open:   return "open";
+        case MapKind::Maze:   return "maze";
+        case MapKind::Random: return "random";
+    }
+    return "?";
+}
+
+inline std::optional<MapKind> parseMapKind(const std::string& name) {
+    if (name == "open")   return MapKind::Open;
+    if (name == "maze")   return MapKind::Maze;
+    if (name == "random") return MapKind::Random;
+    return std::nullopt;
+}
+
+inline const char* mazeAlgorithmName(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+        case MazeAlgorithm::Backtracker: return "backtracker";
+        case MazeAlgorithm::Eller:       return "eller";
+        case MazeAlgorithm::Kruskal:     return "kruskal";
+        case MazeAlgorithm::Wilson:      return "wilson";
+    }
+    return "?";
+}
+
+inline std::optional<MazeAlgorithm> parseMazeAlgorithm(const std::string& name) {
+    if (name == "backtracker") return MazeAlgorithm::Backtracker;
+    if (name == "eller")       return MazeAlgorithm::Eller;
+    if (name == "kruskal")     return MazeAlgorithm::Kruskal;
+    if (name == "wilson")      return MazeAlgorithm::Wilson;
+    return std::nullopt;
+}
+
+// Zgradi mrežo cols x rows. Za isti seed je mreža vedno enaka.
+// density (0..1) je delež zidov in velja samo za MapKind::Random.
+// maxCost > 1 doda naključen teren s cenami 1..maxCost (zidovi ostanejo
+// enaki kot pri maxCost = 1, da se da primerjati uteženo in neuteženo).
+// Start je v levem zgornjem, end v desnem spodnjem kotu
+// (pri labirintu ju postavi generateMaze()). maze izbere generator labirinta;
+// z mazePool se labirint generira po ploščicah na nitih bazena.
+inline Grid makeBenchGrid(MapKind kind, int cols, int rows,
+                          double density, std::uint32_t seed, int maxCost = 1,
+                          MazeAlgorithm maze = MazeAlgorithm::Backtracker,
+                          ThreadPool* mazePool = nullptr) {
+    Grid grid(cols, rows, 1);
+
+    if (maxCost > 1) {
+        std::mt19937 rng{seed ^ 0x9E3779B9u};
+        std::uniform_int_distribution<int> cost(Grid::MinCost, maxCost);
+        for (int y = 0; y < rows; ++y)
+            for (int x = 0; x < cols; ++x)
+                grid.setCost(x, y, cost(rng));
+    }
+
+    switch (kind) {
+        case MapKind::Open:
+            break;
+
+        case MapKind::Maze:
+            if (mazePool)
+                grid.generateMaze(seed, maze, *mazePool);
+            else
+                grid.generateMaze(seed, maze);
+            return grid;
+
+        case MapKind::Random: {
+            std::mt19937 rng{seed};
+            std::bernoulli_distribution wall(density);
+            for (int y = 0; y < rows; ++y)
+                for (int x = 0; x < cols; ++x)
+                    if (wall(rng))
+                        grid.setWall(x, y, true);
+
+            // kota očistimo, da start/end nista zazidana v svojem žepu
+            for (int dy = 0; dy < 3; ++dy) {
+                for (int dx = 0; dx < 3; ++dx) {
+                    grid.setWall(dx, dy, false);
+                    grid.setWall(cols - 1 - dx, rows - 1 - dy, false);
+                }
+            }
+            break;
+        }
+    }
+
+    grid.setStart(0, 0);
+    grid.setEnd(cols - 1, rows - 1);
+    return grid;
+}
+
+// count naključnih poizvedb med prostimi celicami mreže (za paketne meritve);
+// za isti seed so poizvedbe vedno enake. Mreža mora imeti vsaj eno prosto celico.
+inline std::vector<PathQuery> makeBenchQueries(const Grid& grid, int count,
+                                               std::uint32_t seed) {
+    std::mt19937 rng{seed ^ 0x51A7C0DEu};
+    std::uniform_int_distribution<int> col(0, grid.getCols() - 1);
+    std::uniform_int_distribution<int> row(0, grid.getRows() - 1);
+    auto openCell = [&] {
+        sf::Vector2i p{col(rng), row(rng)};
+        while (grid.isWall(p.x, p.y))
+            p = {col(rng), row(rng)};
+        return p;
+    };
+
+    std::vector<PathQuery> queries(count);
+    for (auto& q : queries) {
+        q.start = openCell();
+        q.goal  = openCell();
+    }
+    return queries;
+}
@@ -0,0 +1,4 @@
+#include "BidirectionalRunner.hpp"
+
+template class BidirectionalSearch<FifoOpenList, Neighbors4, UnitCost, ZeroHeuristic>;
+template class BidirectionalSearch<HeapOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
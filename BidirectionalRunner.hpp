@@ -0,0 +1,401 @@
+#pragma once
+
+#include "Grid.hpp"
+#include "SearchPolicies.hpp"
+#include "SearchWorkspace.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// Dvosmerno iskanje: hkrati razširjamo od starta (naprej) in od cilja
+// (nazaj). Vsak step() razširi eno vozlišče iz manjše fronte. Ko se fronti
+// srečata, si zapomnimo najboljšo ceno poti mu skozi skupno celico, iskanje
+// pa se ustavi šele, ko nobena neraziskana pot ne more biti cenejša:
+// zadnji ključ naprej + zadnji ključ nazaj >= 2 * mu.
+//
+// Obe smeri uporabljata isti potencial p(v) = (h(v, cilj) - h(v, start)) / 2
+// (naprej +p, nazaj -p), da ostaneta konsistentni in se pogoj zaustavitve
+// ujema z dvosmernim Dijkstro. Ključ je podvojen, da ostane celo število:
+// 2g + h(v, cilj smeri) - h(v, izvor smeri). Brez hevristike je ključ 2g.
+// Ključi iz open lista ne padajo, zato je zadnji vzeti ključ spodnja meja fronte.
+//
+// Politike so iste kot pri SearchRunner. Cena premika je cena vstopa v celico,
+// zato nazaj korak cur -> prev stane cost(cur). Soseščina mora biti
+// simetrična, z nasprotnimi smermi v parih (d, d ^ 1), kot Neighbors4.
+// Vsaka smer ima svoj SearchWorkspace in open list iz WorkspacePool.
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+class BidirectionalSearch {
+public:
+    explicit BidirectionalSearch(const Grid& grid);
+
+    // novo iskanje od start do goal na isti mreži (kot SearchRunner::reset)
+    void reset(sf::Vector2i start, sf::Vector2i goal);
+
+    // izvede en korak (razširi eno vozlišče); vrne true, ko je algoritem končan
+    bool step();
+
+    // zapis spremenjenih celic za izris (kot SearchRunner::setChangeLog)
+    void setChangeLog(ChangeLog* log) { m_changes = log; }
+
+    bool isFinished() const { return m_finished; }
+    bool hasPath()    const { return m_pathFound; }
+
+    // open/closed v kateri koli smeri (za generično risanje in statistiko)
+    bool isOpen(int gx, int gy) const {
+        return hasFlag(Forward, gx, gy, Open) || hasFlag(Backward, gx, gy, Open);
+    }
+    bool isClosed(int gx, int gy) const {
+        return hasFlag(Forward, gx, gy, Closed) || hasFlag(Backward, gx, gy, Closed);
+    }
+    bool isInPath(int gx, int gy) const { return hasFlag(Forward, gx, gy, InPath); }
+
+    // celico je dosegla samo fronta od cilja (vizualizator jo obarva drugače)
+    bool isBackward(int gx, int gy) const {
+        return hasFlag(Backward, gx, gy, Open | Closed) &&
+               !hasFlag(Forward, gx, gy, Open | Closed);
+    }
+
+    // razdalja od starta (samo fronta naprej)
+    int getGScore(int gx, int gy) const {
+        if (!inBounds(gx, gy)) return INF;
+        return m_side[Forward].ws->g(m_grid->cellIndex(gx, gy));
+    }
+
+    // skupna cena najdene poti, -1 če poti ni
+    int getPathCost() const { return m_pathFound ? m_bestCost : -1; }
+
+    const std::vector<sf::Vector2i>& getPath() const { return m_path; }
+
+    // statistika za HUD (vsota obeh smeri)
+    int getVisitedCount() const { return m_visitedCount; }
+    int getOpenMaxSize()  const { return m_openMaxSize;  }
+    int getPathLength()   const { return m_pathLength;   }
+
+    static constexpr int INF = std::numeric_limits<int>::max();
+
+private:
+    // microbenchmark meri buildPath() posebej
+    friend struct RunnerBenchAccess;
+
+    static_assert([] {
+        for (int d = 0; d < Neighborhood::Count; ++d)
+            if (Neighborhood::Dirs[d].x != -Neighborhood::Dirs[d ^ 1].x ||
+                Neighborhood::Dirs[d].y != -Neighborhood::Dirs[d ^ 1].y)
+                return false;
+        return true;
+    }(), "BidirectionalSearch needs opposite directions in pairs (d, d ^ 1)");
+
+    enum Direction { Forward = 0, Backward = 1 };
+
+    // zastavice v delovnem prostoru smeri; InPath samo v smeri naprej
+    enum Flag : std::uint8_t {
+        Open   = 1 << 0,
+        Closed = 1 << 1,
+        InPath = 1 << 2
+    };
+
+    // stanje ene smeri iskanja
+    struct Side {
+        typename WorkspacePool<SearchWorkspace>::Lease ws; // g in smer starša proti izvoru te smeri
+        typename WorkspacePool<OpenList>::Lease open;
+        int lastKey = 0;         // ključ zadnjega vzetega vozlišča
+        sf::Vector2i source{};   // izvor te smeri
+        sf::Vector2i target{};   // izvor druge smeri
+
+        explicit Side(int cellCount)
+            : ws(WorkspacePool<SearchWorkspace>::shared().acquire(cellCount)),
+              open(WorkspacePool<OpenList>::shared().acquire(cellCount)) {}
+    };
+
+    const Grid* m_grid = nullptr;
+    int m_rows = 0;
+    int m_cols = 0;
+
+    int m_startCell = -1;
+    int m_endCell   = -1;
+
+    Side m_side[2];
+    std::vector<sf::Vector2i> m_path;
+    ChangeLog* m_changes = nullptr;
+
+    Neighborhood m_neighborhood;
+
+    int m_bestCost = INF; // najboljša znana cena poti (mu)
+    int m_meetCell = -1;  // celica, skozi katero gre ta pot
+
+    bool m_finished = false;
+    bool m_pathFound = false;
+
+    // števci za HUD
+    int m_visitedCount = 0;
+    int m_openMaxSize  = 0;
+    int m_pathLength   = 0;
+
+    bool inBounds(int gx, int gy) const {
+        return gx >= 0 && gx < m_cols && gy >= 0 && gy < m_rows;
+    }
+
+    bool hasFlag(int dir, int gx, int gy, std::uint8_t mask) const {
+        if (!inBounds(gx, gy)) return false;
+        return m_side[dir].ws->flags(m_grid->cellIndex(gx, gy)) & mask;
+    }
+
+    // podvojen ključ s povprečnim potencialom (glej zgoraj)
+    static int keyOf(const Side& side, int g, int x, int y) {
+        return 2 * g + Heuristic::estimate(x, y, side.target.x, side.target.y)
+                     - Heuristic::estimate(x, y, side.source.x, side.source.y);
+    }
+
+    void logChange(int cell) {
+        if (m_changes) m_changes->add(cell);
+    }
+
+    void pushOpen(int dir, SearchWorkspace::Cell& c, int cell, int key) {
+        m_side[dir].open->push(cell, key, c.g);
+        if (!(c.flags & Open)) logChange(cell);
+        c.flags |= Open;
+        m_openMaxSize = std::max(m_openMaxSize,
+                                 m_side[Forward].open->size() + m_side[Backward].open->size());
+    }
+
+    // nobena neraziskana pot ne more biti cenejša od m_bestCost
+    bool canStop() const {
+        if (m_bestCost == INF)
+            return false;
+        return static_cast<long long>(m_side[Forward].lastKey) + m_side[Backward].lastKey >=
+               2LL * m_bestCost;
+    }
+
+    static_assert(Neighborhood::Count <= SearchWorkspace::MaxDirs);
+    // pot se sestavlja po sosednjih celicah, zato soseščina ne sme skakati (JPS)
+    static_assert(std::is_same_v<Neighborhood, Neighbors4> || std::is_same_v<Neighborhood, Neighbors8>);
+
+    // starš celice v smeri dir: sosed v nasprotni smeri prihoda; -1 za izvor
+    int parentOf(int dir, int cell) const;
+
+    void expand(int dir, int cur);
+    void finish(bool found);
+    void buildPath(); // start -> celica srečanja -> cilj
+};
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+BidirectionalSearch<OpenList, Neighborhood, CostModel, Heuristic>::BidirectionalSearch(
+    const Grid& grid)
+    : m_grid(&grid),
+      m_rows(grid.getRows()),
+      m_cols(grid.getCols()),
+      m_side{Side(grid.cellCount()), Side(grid.cellCount())},
+      m_neighborhood(grid)
+{
+    auto startOpt = grid.getStart();
+    auto endOpt   = grid.getEnd();
+
+    if (!startOpt || !endOpt) {
+        m_finished = true;
+        return;
+    }
+
+    reset(*startOpt, *endOpt);
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+void BidirectionalSearch<OpenList, Neighborhood, CostModel, Heuristic>::reset(
+    sf::Vector2i start, sf::Vector2i end)
+{
+    for (Side& side : m_side) {
+        side.ws->clear();
+        side.open->clear();
+        side.lastKey = 0;
+    }
+    m_path.clear();
+    if (m_changes) m_changes->addAll();
+
+    m_bestCost = INF;
+    m_meetCell = -1;
+    m_finished = false;
+    m_pathFound = false;
+    m_visitedCount = 0;
+    m_openMaxSize  = 0;
+    m_pathLength   = 0;
+    m_startCell = -1;
+    m_endCell   = -1;
+
+    // če je start ali end izven mreže ali na zidu ali sta v različnih
+    // komponentah, nima smisla iskati poti
+    if (!inBounds(start.x, start.y) || !inBounds(end.x, end.y) ||
+        !m_grid->connected(start, end)) {
+        m_finished = true;
+        return;
+    }
+
+    m_startCell = m_grid->cellIndex(start.x, start.y);
+    m_endCell   = m_grid->cellIndex(end.x, end.y);
+
+    m_side[Forward].source  = start;
+    m_side[Forward].target  = end;
+    m_side[Backward].source = end;
+    m_side[Backward].target = start;
+
+    SearchWorkspace::Cell& first = m_side[Forward].ws->cell(m_startCell);
+    SearchWorkspace::Cell& last  = m_side[Backward].ws->cell(m_endCell);
+    first.g = 0;
+    last.g  = 0;
+    pushOpen(Forward,  first, m_startCell, keyOf(m_side[Forward],  0, start.x, start.y));
+    pushOpen(Backward, last,  m_endCell,   keyOf(m_side[Backward], 0, end.x, end.y));
+
+    if (m_startCell == m_endCell) {
+        m_bestCost = 0;
+        m_meetCell = m_startCell;
+    }
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+bool BidirectionalSearch<OpenList, Neighborhood, CostModel, Heuristic>::step() {
+    if (m_finished || !m_grid)
+        return true;
+
+    for (;;) {
+        // ko je ena smer izčrpana, so vse poti iz nje že znane
+        if (m_side[Forward].open->empty() || m_side[Backward].open->empty()) {
+            finish(m_bestCost != INF);
+            return true;
+        }
+
+        // razširjamo manjšo fronto, da ostaneta uravnoteženi
+        const int dir = m_side[Backward].open->size() < m_side[Forward].open->size()
+                            ? Backward : Forward;
+        Side& side = m_side[dir];
+
+        const int cur = side.open->pop();
+        SearchWorkspace::Cell& c = side.ws->cell(cur);
+
+        // zastarel zapis (celica je bila v tej smeri že razširjena)
+        if (c.flags & Closed)
+            continue;
+
+        const sf::Vector2i pos = m_grid->cellPos(cur);
+        side.lastKey = keyOf(side, c.g, pos.x, pos.y);
+        if (canStop()) {
+            finish(true);
+            return true;
+        }
+
+        c.flags = static_cast<std::uint8_t>((c.flags & ~Open) | Closed);
+        logChange(cur);
+        ++m_visitedCount;
+
+        expand(dir, cur);
+
+        // v enem frame-u obdelamo eno vozlišče
+        return false;
+    }
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+void BidirectionalSearch<OpenList, Neighborhood, CostModel, Heuristic>::expand(int dir, int cur) {
+    Side& side = m_side[dir];
+    const Side& other = m_side[dir ^ 1];
+
+    const sf::Vector2i pos = m_grid->cellPos(cur);
+    const int g = side.ws->g(cur);
+
+    auto relax = [&](int next, int d, int steps) {
+        SearchWorkspace::Cell& n = side.ws->cell(next);
+        if (n.flags & Closed)
+            return;
+
+        // naprej plačamo vstop v next, nazaj vstop v cur (premik next -> cur)
+        const int stepCost = dir == Forward
+            ? CostModel::cost(*m_grid, next, d)
+            : CostModel::cost(*m_grid, cur, d ^ 1);
+        const int tentativeG = g + stepCost * steps;
+        if (tentativeG >= n.g)
+            return;
+
+        n.g = tentativeG;
+        n.setParentDir(d);
+
+        // fronti sta se srečali v next
+        const int otherG = other.ws->g(next);
+        if (otherG != INF && tentativeG + otherG < m_bestCost) {
+            m_bestCost = tentativeG + otherG;
+            m_meetCell = next;
+        }
+
+        const int nx = pos.x + Neighborhood::Dirs[d].x * steps;
+        const int ny = pos.y + Neighborhood::Dirs[d].y * steps;
+        pushOpen(dir, n, next, keyOf(side, tentativeG, nx, ny));
+    };
+    const sf::Vector2i target = side.target;
+    m_neighborhood.forEach(*m_grid, pos, cur, side.ws->parentDir(cur), target, relax);
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+int BidirectionalSearch<OpenList, Neighborhood, CostModel, Heuristic>::parentOf(
+    int dir, int cell) const
+{
+    const SearchWorkspace& ws = *m_side[dir].ws;
+    const int d = ws.parentDir(cell);
+    if (d == -1)
+        return -1;
+
+    // brez skokov je starš vedno sosednja celica v nasprotni smeri prihoda
+    return cell - (Neighborhood::Dirs[d].x + Neighborhood::Dirs[d].y * m_grid->paddedCols());
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+void BidirectionalSearch<OpenList, Neighborhood, CostModel, Heuristic>::finish(bool found) {
+    m_finished = true;
+    m_pathFound = found;
+    if (found)
+        buildPath();
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+void BidirectionalSearch<OpenList, Neighborhood, CostModel, Heuristic>::buildPath() {
+    // počistimo samo celice prejšnje poti
+    SearchWorkspace& forward = *m_side[Forward].ws;
+
+    for (const auto& p : m_path) {
+        forward.cell(m_grid->cellIndex(p.x, p.y)).flags &= static_cast<std::uint8_t>(~InPath);
+        logChange(m_grid->cellIndex(p.x, p.y));
+    }
+    m_path.clear();
+
+    // od srečanja nazaj do starta, obrnemo, nato od srečanja naprej do cilja
+    for (int cur = m_meetCell; cur != -1; cur = parentOf(Forward, cur)) {
+        forward.cell(cur).flags |= InPath;
+        logChange(cur);
+        m_path.push_back(m_grid->cellPos(cur));
+    }
+    std::reverse(m_path.begin(), m_path.end());
+
+    // celice le od zadaj v smeri naprej še niso zapisane; cell() jih doda
+    for (int cur = parentOf(Backward, m_meetCell); cur != -1; cur = parentOf(Backward, cur)) {
+        forward.cell(cur).flags |= InPath;
+        logChange(cur);
+        m_path.push_back(m_grid->cellPos(cur));
+    }
+
+    m_pathLength = static_cast<int>(m_path.size());
+}
+
+using BidirectionalBFSSearch = BidirectionalSearch<FifoOpenList, Neighbors4, UnitCost, ZeroHeuristic>;
+extern template class BidirectionalSearch<FifoOpenList, Neighbors4, UnitCost, ZeroHeuristic>;
+
+using BidirectionalAStarSearch = BidirectionalSearch<HeapOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
+extern template class BidirectionalSearch<HeapOpenList, Neighbors4, TerrainCost, ManhattanHeuristic>;
+
+// dvosmerni BFS (vsak korak stane 1)
+class BidirectionalBFSRunner : public BidirectionalBFSSearch {
+public:
+    using BidirectionalBFSSearch::BidirectionalBFSSearch;
+};
+
+// dvosmerni A* (teren, Manhattan v obe smeri)
+class BidirectionalAStarRunner : public BidirectionalAStarSearch {
+public:
+    using BidirectionalAStarSearch::BidirectionalAStarSearch;
+};
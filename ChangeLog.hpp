@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Dnevnik spremenjenih celic (indeksi Grid::cellIndex) za porabnika, ki hrani
+// svojo kopijo stanja celic, npr. izris mreže. Mreža vanj zapiše spremembe
+// zidov, terena in starta/cilja, runner pa spremembe open/closed/path.
+// Porabnik ob priliki prebere cells() (ali allChanged()) in pokliče clear().
+//
+// Ko je zapisov več kot limit ali se spremeni vse naenkrat (clearAll,
+// labirint, reset runnerja), si dnevnik zapomni samo "vse", zato pomnilnik ne
+// raste brez meje, tudi če ga nihče ne prazni. Celica je lahko zapisana večkrat.
+class ChangeLog {
+public:
+    explicit ChangeLog(std::size_t limit = 1 << 16) : m_limit(limit) {}
+
+    void add(int cell) {
+        if (m_all)
+            return;
+        if (m_cells.size() >= m_limit) {
+            addAll();
+            return;
+        }
+        m_cells.push_back(cell);
+    }
+
+    void addAll() {
+        m_all = true;
+        m_cells.clear();
+    }
+
+    bool allChanged() const { return m_all; }
+    bool empty() const { return !m_all && m_cells.empty(); }
+    const std::vector<int>& cells() const { return m_cells; }
+
+    void clear() {
+        m_all = false;
+        m_cells.clear();
+    }
+
+private:
+    std::size_t m_limit;
+    std::vector<int> m_cells;
+    bool m_all = true; // porabnik na začetku ne ve ničesar
+};
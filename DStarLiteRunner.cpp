@@ -0,0 +1,306 @@
+#include "DStarLiteRunner.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+DStarLiteRunner::DStarLiteRunner(const Grid& grid)
+    : m_grid(&grid),
+      m_g(grid.cellCount(), INF),
+      m_rhs(grid.cellCount(), INF),
+      m_heapPos(grid.cellCount(), -1),
+      m_inPath(grid.cellCount(), 0)
+{
+    auto startOpt = grid.getStart();
+    auto endOpt   = grid.getEnd();
+
+    if (!startOpt || !endOpt) {
+        m_finished = true;
+        return;
+    }
+
+    reset(*startOpt, *endOpt);
+}
+
+void DStarLiteRunner::reset(sf::Vector2i start, sf::Vector2i goal) {
+    std::fill(m_g.begin(), m_g.end(), INF);
+    std::fill(m_rhs.begin(), m_rhs.end(), INF);
+    for (const HeapEntry& e : m_heap)
+        m_heapPos[e.cell] = -1;
+    m_heap.clear();
+    clearPath();
+    if (m_changes) m_changes->addAll();
+
+    m_km = 0;
+    m_finished = false;
+    m_pathFound = false;
+    m_visitedCount = 0;
+    m_openMaxSize  = 0;
+
+    if (!m_grid->inBounds(start.x, start.y) || !m_grid->inBounds(goal.x, goal.y)) {
+        m_active = false;
+        m_finished = true;
+        return;
+    }
+
+    // v različnih komponentah poti ni; m_active ostane false, zato naslednji
+    // gridChanged() začne znova in preveri, ali ju je urejanje povezalo
+    if (!m_grid->connected(start, goal)) {
+        m_active = false;
+        m_finished = true;
+        return;
+    }
+
+    m_start = start;
+    m_last  = start;
+    m_goal  = goal;
+    m_startCell = m_grid->cellIndex(start.x, start.y);
+    m_goalCell  = m_grid->cellIndex(goal.x, goal.y);
+    m_active = true;
+
+    m_rhs[m_goalCell] = 0;
+    heapSet(m_goalCell, calculateKey(m_goalCell));
+}
+
+void DStarLiteRunner::gridChanged(sf::Vector2i cell) {
+    const auto startOpt = m_grid->getStart();
+    const auto endOpt   = m_grid->getEnd();
+
+    // nov cilj pomeni novo drevo cen; brez cilja ali starta počakamo
+    if (!m_active || (endOpt && *endOpt != m_goal)) {
+        if (startOpt && endOpt) {
+            reset(*startOpt, *endOpt);
+        } else {
+            m_active = false;
+            m_finished = true;
+            m_pathFound = false;
+            clearPath();
+        }
+        return;
+    }
+
+    // spremenijo se povezave v celico in iz nje
+    if (m_grid->inBounds(cell.x, cell.y)) {
+        const int c = m_grid->cellIndex(cell.x, cell.y);
+        updateVertex(c);
+        updateNeighbors(c);
+    }
+    m_visitedCount = 0;
+
+    // stanje ostane veljavno za isti cilj, tudi ko starta ali cilja začasno ni
+    if (!startOpt || !endOpt) {
+        m_finished = true;
+        m_pathFound = false;
+        clearPath();
+        return;
+    }
+
+    if (*startOpt != m_start) {
+        m_km += std::abs(m_last.x - startOpt->x) + std::abs(m_last.y - startOpt->y);
+        m_last = *startOpt;
+        m_start = *startOpt;
+        m_startCell = m_grid->cellIndex(m_start.x, m_start.y);
+    }
+    m_finished = false;
+}
+
+bool DStarLiteRunner::step() {
+    if (m_finished)
+        return true;
+
+    // ComputeShortestPath: dokler je v open listu kaj pred startom ali je start nekonsistenten
+    while (!m_heap.empty()) {
+        const Key top = m_heap[0].key;
+        if (!(top < calculateKey(m_startCell)) && m_rhs[m_startCell] == m_g[m_startCell])
+            break;
+
+        const int u = m_heap[0].cell;
+        const Key fresh = calculateKey(u);
+
+        // ključ je zastarel zaradi premika starta (km), samo ga posodobimo
+        if (top < fresh) {
+            heapSet(u, fresh);
+            continue;
+        }
+
+        if (m_g[u] > m_rhs[u]) {
+            // celica se je pocenila: postane konsistentna, sosedje jo lahko uporabijo
+            m_g[u] = m_rhs[u];
+            logChange(u);
+            heapRemove(u);
+            updateNeighbors(u);
+        } else {
+            // celica se je podražila: pozabimo g, nato popravimo njo in sosede
+            m_g[u] = INF;
+            logChange(u);
+            updateVertex(u);
+            updateNeighbors(u);
+        }
+        ++m_visitedCount;
+
+        // v enem frame-u obdelamo eno vozlišče
+        return false;
+    }
+
+    m_finished = true;
+    m_pathFound = m_g[m_startCell] != INF && !m_grid->isWall(m_start.x, m_start.y);
+    if (m_pathFound)
+        buildPath();
+    else
+        clearPath();
+    return true;
+}
+
+DStarLiteRunner::Key DStarLiteRunner::calculateKey(int cell) const {
+    const int m = std::min(m_g[cell], m_rhs[cell]);
+    if (m == INF)
+        return Key{};
+
+    const sf::Vector2i pos = m_grid->cellPos(cell);
+    const int h = std::abs(pos.x - m_start.x) + std::abs(pos.y - m_start.y);
+    return Key{m + h + m_km, m};
+}
+
+void DStarLiteRunner::updateVertex(int cell) {
+    if (cell != m_goalCell) {
+        int best = INF;
+        const sf::Vector2i pos = m_grid->cellPos(cell);
+        if (!m_grid->isWall(pos.x, pos.y)) {
+            const int w = m_grid->paddedCols();
+            const int offsets[4] = {1, -1, w, -w};
+            unsigned open = m_grid->openNeighbors4(pos.x, pos.y);
+            while (open) {
+                const int v = cell + offsets[std::countr_zero(open)];
+                open &= open - 1;
+                if (m_g[v] != INF)
+                    best = std::min(best, m_grid->costAt(v) + m_g[v]);
+            }
+        }
+        m_rhs[cell] = best;
+    }
+
+    if (m_g[cell] != m_rhs[cell])
+        heapSet(cell, calculateKey(cell));
+    else if (m_heapPos[cell] != -1)
+        heapRemove(cell);
+}
+
+// sosedje celice ob robu so celice roba mreže; so zid in ostanejo INF
+void DStarLiteRunner::updateNeighbors(int cell) {
+    const int w = m_grid->paddedCols();
+    updateVertex(cell + 1);
+    updateVertex(cell - 1);
+    updateVertex(cell + w);
+    updateVertex(cell - w);
+}
+
+void DStarLiteRunner::heapSet(int cell, Key key) {
+    int i = m_heapPos[cell];
+    if (i == -1) {
+        i = static_cast<int>(m_heap.size());
+        m_heap.push_back(HeapEntry{key, cell});
+        m_heapPos[cell] = i;
+        logChange(cell);
+        m_openMaxSize = std::max(m_openMaxSize, static_cast<int>(m_heap.size()));
+        siftUp(i);
+        return;
+    }
+
+    const Key old = m_heap[i].key;
+    m_heap[i].key = key;
+    if (key < old)
+        siftUp(i);
+    else
+        siftDown(i);
+}
+
+void DStarLiteRunner::heapRemove(int cell) {
+    const int i = m_heapPos[cell];
+    const int last = static_cast<int>(m_heap.size()) - 1;
+    if (i != last) {
+        heapSwap(i, last);
+        m_heap.pop_back();
+        siftUp(i);
+        siftDown(i);
+    } else {
+        m_heap.pop_back();
+    }
+    m_heapPos[cell] = -1;
+    logChange(cell);
+}
+
+void DStarLiteRunner::siftUp(int i) {
+    while (i > 0) {
+        const int parent = (i - 1) / 2;
+        if (!(m_heap[i].key < m_heap[parent].key))
+            break;
+        heapSwap(i, parent);
+        i = parent;
+    }
+}
+
+void DStarLiteRunner::siftDown(int i) {
+    const int n = static_cast<int>(m_heap.size());
+    for (;;) {
+        int smallest = i;
+        const int l = 2 * i + 1;
+        const int r = l + 1;
+        if (l < n && m_heap[l].key < m_heap[smallest].key) smallest = l;
+        if (r < n && m_heap[r].key < m_heap[smallest].key) smallest = r;
+        if (smallest == i)
+            break;
+        heapSwap(i, smallest);
+        i = smallest;
+    }
+}
+
+void DStarLiteRunner::heapSwap(int i, int j) {
+    std::swap(m_heap[i], m_heap[j]);
+    m_heapPos[m_heap[i].cell] = i;
+    m_heapPos[m_heap[j].cell] = j;
+}
+
+void DStarLiteRunner::clearPath() {
+    for (const auto& p : m_path) {
+        m_inPath[m_grid->cellIndex(p.x, p.y)] = 0;
+        logChange(m_grid->cellIndex(p.x, p.y));
+    }
+    m_path.clear();
+    m_pathLength = 0;
+}
+
+void DStarLiteRunner::buildPath() {
+    // počistimo samo celice prejšnje poti
+    clearPath();
+
+    // g je cena do cilja, zato od starta vedno stopimo na soseda z najmanjšo
+    // ceno(v) + g(v); omejitev korakov varuje pred zanko ob napaki v stanju
+    const int w = m_grid->paddedCols();
+    const int offsets[4] = {1, -1, w, -w};
+    int cur = m_startCell;
+    m_path.push_back(m_start);
+    for (int guard = 0; cur != m_goalCell && guard < m_grid->cellCount(); ++guard) {
+        const sf::Vector2i pos = m_grid->cellPos(cur);
+        int best = INF;
+        int next = -1;
+        unsigned open = m_grid->openNeighbors4(pos.x, pos.y);
+        while (open) {
+            const int v = cur + offsets[std::countr_zero(open)];
+            open &= open - 1;
+            if (m_g[v] != INF && m_grid->costAt(v) + m_g[v] < best) {
+                best = m_grid->costAt(v) + m_g[v];
+                next = v;
+            }
+        }
+        if (next == -1)
+            break;
+        cur = next;
+        m_path.push_back(m_grid->cellPos(cur));
+    }
+
+    for (const auto& p : m_path) {
+        m_inPath[m_grid->cellIndex(p.x, p.y)] = 1;
+        logChange(m_grid->cellIndex(p.x, p.y));
+    }
+    m_pathLength = static_cast<int>(m_path.size());
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Grid.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// D* Lite (Koenig & Likhachev): inkrementalno iskanje od cilja proti startu.
+// Za vsako celico hrani g (znana cena do cilja) in rhs (ocena iz sosedov:
+// min cena(v) + g(v)); celica z g != rhs je nekonsistentna in je v open listu.
+// Ko se mreža spremeni (zid, teren, premik starta), gridChanged() popravi rhs
+// samo spremenjene celice in njenih sosedov, iskanje pa nato razširi le
+// celice, na katere sprememba dejansko vpliva. Premik starta ne razveljavi
+// ničesar: ključem se prišteje km (kot v originalnem algoritmu).
+//
+// Premiki so 4-sosedski, cena vstopa v celico je njen teren (kot TerrainCost),
+// hevristika je Manhattan. Vmesnik je enak kot pri SearchRunner, en step()
+// razširi eno vozlišče; getGScore() vrne ceno do cilja.
+class DStarLiteRunner {
+public:
+    explicit DStarLiteRunner(const Grid& grid);
+
+    // novo iskanje od start do goal (vse prejšnje stanje se zavrže)
+    void reset(sf::Vector2i start, sf::Vector2i goal);
+
+    // Celica cell na mreži se je spremenila (setWall, clearCell, setCost,
+    // setStart, setEnd). Start in end se prebereta iz mreže: premik starta se
+    // popravi inkrementalno, nov cilj pa začne iskanje znova (cilj je koren).
+    // Naslednji step() nadaljuje popravljanje; prejšnja pot ostane do konca.
+    void gridChanged(sf::Vector2i cell);
+
+    // izvede en korak (razširi eno vozlišče); vrne true, ko je algoritem končan
+    bool step();
+
+    // zapis spremenjenih celic za izris (kot SearchRunner::setChangeLog)
+    void setChangeLog(ChangeLog* log) { m_changes = log; }
+
+    bool isFinished() const { return m_finished; }
+    bool hasPath()    const { return m_pathFound; }
+
+    bool isOpen(int gx, int gy) const {
+        return m_grid->inBounds(gx, gy) && m_heapPos[m_grid->cellIndex(gx, gy)] != -1;
+    }
+    // celica z znano ceno do cilja, ki ni v open listu
+    bool isClosed(int gx, int gy) const {
+        if (!m_grid->inBounds(gx, gy)) return false;
+        const int cell = m_grid->cellIndex(gx, gy);
+        return m_g[cell] != INF && m_heapPos[cell] == -1;
+    }
+    bool isInPath(int gx, int gy) const {
+        return m_grid->inBounds(gx, gy) && m_inPath[m_grid->cellIndex(gx, gy)];
+    }
+
+    // cena od celice do cilja (iskanje teče od cilja)
+    int getGScore(int gx, int gy) const {
+        if (!m_grid->inBounds(gx, gy)) return INF;
+        return m_g[m_grid->cellIndex(gx, gy)];
+    }
+
+    int getPathCost() const { return m_pathFound ? m_g[m_startCell] : -1; }
+
+    const std::vector<sf::Vector2i>& getPath() const { return m_path; }
+
+    // statistika za HUD; visited šteje razširitve od zadnje spremembe mreže
+    int getVisitedCount() const { return m_visitedCount; }
+    int getOpenMaxSize()  const { return m_openMaxSize;  }
+    int getPathLength()   const { return m_pathLength;   }
+
+    static constexpr int INF = std::numeric_limits<int>::max();
+
+private:
+    // microbenchmark meri buildPath() posebej
+    friend struct RunnerBenchAccess;
+
+    // ključ [min(g, rhs) + h(start, u) + km, min(g, rhs)], leksikografsko
+    struct Key {
+        int k1 = INF;
+        int k2 = INF;
+        bool operator<(const Key& o) const { return k1 < o.k1 || (k1 == o.k1 && k2 < o.k2); }
+    };
+
+    struct HeapEntry {
+        Key key;
+        int cell;
+    };
+
+    const Grid* m_grid = nullptr;
+
+    sf::Vector2i m_start{};
+    sf::Vector2i m_goal{};
+    sf::Vector2i m_last{};   // start ob zadnjem popravku km
+    int m_startCell = -1;
+    int m_goalCell  = -1;
+    int m_km = 0;
+    bool m_active = false;   // start in cilj sta znana, stanje je veljavno
+
+    std::vector<int> m_g;       // po Grid::cellIndex
+    std::vector<int> m_rhs;
+    std::vector<int> m_heapPos; // indeks v m_heap ali -1
+    std::vector<HeapEntry> m_heap;
+
+    std::vector<std::uint8_t> m_inPath;
+    std::vector<sf::Vector2i> m_path;
+    ChangeLog* m_changes = nullptr;
+
+    bool m_finished = false;
+    bool m_pathFound = false;
+
+    // števci za HUD
+    int m_visitedCount = 0;
+    int m_openMaxSize  = 0;
+    int m_pathLength   = 0;
+
+    Key calculateKey(int cell) const;
+    void updateVertex(int cell);
+    void updateNeighbors(int cell); // updateVertex za 4 sosede
+
+    void heapSet(int cell, Key key); // vstavi ali posodobi
+    void heapRemove(int cell);
+    void siftUp(int i);
+    void siftDown(int i);
+    void heapSwap(int i, int j);
+
+    void logChange(int cell) {
+        if (m_changes) m_changes->add(cell);
+    }
+
+    void clearPath();
+    void buildPath(); // požrešno po najmanjši ceni(v) + g(v) od starta do cilja
+};
@@ -1,66 +1,59 @@
 #pragma once
 
-#include "Grid.hpp"
-#include <vector>
-#include <queue>
-#include <optional>
-#include <limits>
+#include "SearchRunner.hpp"
 
-class DijkstraRunner {
-public:
-    explicit DijkstraRunner(const Grid& grid);
+// Dijkstra: min-kopica po razdalji od starta, cena koraka je teren ciljne celice
+using DijkstraSearch = SearchRunner<HeapOpenList, Neighbors4, TerrainCost, ZeroHeuristic>;
+extern template class SearchRunner<HeapOpenList, Neighbors4, TerrainCost, ZeroHeuristic>;
 
-    bool step();          // en korak algoritma
+// Dijkstra z bucket queue (Dial): O(1) pop, brez zastarelih zapisov
+using DijkstraBucketSearch = SearchRunner<BucketOpenList, Neighbors4, TerrainCost, ZeroHeuristic>;
+extern template class SearchRunner<BucketOpenList, Neighbors4, TerrainCost, ZeroHeuristic>;
 
-    bool isFinished() const;
-    bool hasPath()   const;
+// Dijkstra z radix heap (za utežene mreže)
+using DijkstraRadixSearch = SearchRunner<RadixHeapOpenList, Neighbors4, TerrainCost, ZeroHeuristic>;
+extern template class SearchRunner<RadixHeapOpenList, Neighbors4, TerrainCost, ZeroHeuristic>;
 
-    bool isOpen(int gx, int gy) const;
-    bool isClosed(int gx, int gy) const;
-    bool isInPath(int gx, int gy) const;
+class DijkstraRunner : public DijkstraSearch {
+public:
+    using DijkstraSearch::DijkstraSearch;
 
-    int getDistance(int gx, int gy) const;
+    Cost getDistance(int gx, int gy) const { return getGScore(gx, gy); }
+};
 
-    // statistika za HUD
-    int getVisitedCount() const { return m_visitedCount; }
-    int getOpenMaxSize()  const { return m_openMaxSize;  }
-    int getPathLength()   const { return m_pathLength;   }
+class DijkstraBucketRunner : public DijkstraBucketSearch {
+public:
+    using DijkstraBucketSearch::DijkstraBucketSearch;
 
-private:
-    const Grid* m_grid = nullptr;
-    int m_rows = 0;
-    int m_cols = 0;
+    Cost getDistance(int gx, int gy) const { return getGScore(gx, gy); }
+};
 
-    sf::Vector2i m_start{};
-    sf::Vector2i m_end{};
+class DijkstraRadixRunner : public DijkstraRadixSearch {
+public:
+    using DijkstraRadixSearch::DijkstraRadixSearch;
 
-    std::vector<std::vector<bool>> m_visited;
-    std::vector<std::vector<bool>> m_inOpen;
-    std::vector<std::vector<bool>> m_inClosed;
-    std::vector<std::vector<std::optional<sf::Vector2i>>> m_parent;
-    std::vector<std::vector<bool>> m_inPath;
-    std::vector<std::vector<int>>  m_distance;
+    Cost getDistance(int gx, int gy) const { return getGScore(gx, gy); }
+};
 
-    static constexpr int INF = std::numeric_limits<int>::max();
+// Dijkstra po 8-sosedski mreži: teren * 10 za raven in * 14 za diagonalni
+// korak; g in ključi so std::int64_t (OctileTerrainCost)
+using Dijkstra8Search = SearchRunner<HeapOpenList64, Neighbors8, OctileTerrainCost<Octile10>, ZeroHeuristic>;
+extern template class SearchRunner<HeapOpenList64, Neighbors8, OctileTerrainCost<Octile10>, ZeroHeuristic>;
 
-    // element v priority queue: (distance, pozicija)
-    using PQEntry = std::pair<int, sf::Vector2i>;
-    struct PQCompare {
-        bool operator()(const PQEntry& a, const PQEntry& b) const {
-            return a.first > b.first; // manjša razdalja ima prednost
-        }
-    };
-    std::priority_queue<PQEntry, std::vector<PQEntry>, PQCompare> m_openPQ;
+// enako z enotami 408 / 577 (sqrt(2) na 2e-6, primerljivo z MovingAI optimalLength)
+using Dijkstra8ExactSearch = SearchRunner<HeapOpenList64, Neighbors8, OctileTerrainCost<OctileExact>, ZeroHeuristic>;
+extern template class SearchRunner<HeapOpenList64, Neighbors8, OctileTerrainCost<OctileExact>, ZeroHeuristic>;
 
-    bool m_finished = false;
-    bool m_pathFound = false;
+class Dijkstra8Runner : public Dijkstra8Search {
+public:
+    using Dijkstra8Search::Dijkstra8Search;
 
-    // statistika za primerjavo algoritmov
-    int m_visitedCount = 0;
-    int m_openMaxSize  = 0;
-    int m_pathLength   = 0;
+    Cost getDistance(int gx, int gy) const { return getGScore(gx, gy); }
+};
+
+class Dijkstra8ExactRunner : public Dijkstra8ExactSearch {
+public:
+    using Dijkstra8ExactSearch::Dijkstra8ExactSearch;
 
-    bool inBounds(int gx, int gy) const;
-    void pushOpen(const sf::Vector2i& pos, int dist); // dodaj v PQ
-    void buildPath();                                  // rekonstrukcija poti
+    Cost getDistance(int gx, int gy) const { return getGScore(gx, gy); }
 };
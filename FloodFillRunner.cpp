@@ -0,0 +1,234 @@
+#include "FloodFillRunner.hpp"
+
+#include <algorithm>
+#include <bit>
+
+BitFloodFill::BitFloodFill(const Grid& grid)
+    : m_grid(&grid),
+      m_cols(grid.getCols()),
+      m_rows(grid.getRows()),
+      m_stride(grid.wordsPerRow()),
+      m_visited(static_cast<std::size_t>(m_rows + 4) * m_stride, 0),
+      m_frontier(m_visited.size(), 0),
+      m_next(m_visited.size(), 0),
+      m_layerLow(m_visited.size(), 0),
+      m_layerHigh(m_visited.size(), 0)
+{
+}
+
+void BitFloodFill::reset(sf::Vector2i source, bool recordLayers) {
+    std::fill(m_visited.begin(), m_visited.end(), Word{0});
+    for (int w : m_active)
+        m_frontier[w] = 0;
+    m_active.clear();
+
+    m_recordLayers = recordLayers;
+    if (m_recordLayers) {
+        std::fill(m_layerLow.begin(), m_layerLow.end(), Word{0});
+        std::fill(m_layerHigh.begin(), m_layerHigh.end(), Word{0});
+    }
+    m_source = source;
+    m_layer = 0;
+    m_visitedCount = 0;
+    m_frontierSize = 0;
+
+    if (!m_grid->inBounds(source.x, source.y) || m_grid->isWall(source.x, source.y))
+        return;
+
+    const int word = wordIndex(source.x, source.y);
+    const Word mask = Word{1} << ((source.x + 1) % Grid::WordBits);
+    m_frontier[word] = mask;
+    m_visited[word]  = mask;
+    m_active.push_back(word);
+
+    m_visitedCount = 1;
+    m_frontierSize = 1;
+}
+
+// Nove celice besede word iz trenutne fronte. Prenos čez mejo besede ne
+// potrebuje preverjanja vrstice: zadnji bit vrstice in bit gx = -1 sta zid,
+// zato ju fronta nikoli nima. Beseda pride v m_fresh samo prvič.
+void BitFloodFill::spreadInto(int word, const Word* walls) {
+    const Word f = m_frontier[word];
+    const Word spread = f | (f << 1) | (f >> 1)
+                      | (m_frontier[word - 1] >> (Grid::WordBits - 1))
+                      | (m_frontier[word + 1] << (Grid::WordBits - 1))
+                      | m_frontier[word - m_stride]
+                      | m_frontier[word + m_stride];
+
+    const Word fresh = spread & ~walls[word - m_stride] & ~m_visited[word];
+    if (fresh && !m_next[word]) {
+        m_next[word] = fresh;
+        m_fresh.push_back(word);
+    }
+}
+
+bool BitFloodFill::advance() {
+    if (m_active.empty())
+        return false;
+
+    // beseda bitseta w je beseda zidu w - m_stride (bitseti imajo vrstico več)
+    const Word* walls = m_grid->wallRow(-1);
+
+    // nova fronta lahko nastane samo v aktivnih besedah in njihovih sosedah
+    m_fresh.clear();
+    for (int w : m_active) {
+        spreadInto(w, walls);
+        spreadInto(w - 1, walls);
+        spreadInto(w + 1, walls);
+        spreadInto(w - m_stride, walls);
+        spreadInto(w + m_stride, walls);
+    }
+
+    for (int w : m_active)
+        m_frontier[w] = 0;
+
+    const int layer = m_layer + 1;
+    const Word low  = (layer & 1) ? ~Word{0} : 0;
+    const Word high = (layer & 2) ? ~Word{0} : 0;
+    m_frontierSize = 0;
+
+    for (int w : m_fresh) {
+        const Word fresh = m_next[w];
+        m_next[w] = 0;
+        m_frontier[w] = fresh;
+        m_visited[w] |= fresh;
+        m_frontierSize += std::popcount(fresh);
+
+        if (m_recordLayers) {
+            m_layerLow[w]  |= fresh & low;
+            m_layerHigh[w] |= fresh & high;
+        }
+    }
+
+    m_active.swap(m_fresh);
+    if (m_active.empty())
+        return false;
+
+    m_layer = layer;
+    m_visitedCount += m_frontierSize;
+    return true;
+}
+
+int BitFloodFill::distance(sf::Vector2i from, sf::Vector2i to) {
+    reset(from, false);
+    if (m_active.empty() || !m_grid->connected(from, to))
+        return -1;
+
+    while (!isVisited(to.x, to.y)) {
+        if (!advance())
+            return -1;
+    }
+    return m_layer;
+}
+
+std::vector<sf::Vector2i> BitFloodFill::pathTo(sf::Vector2i target) const {
+    std::vector<sf::Vector2i> path;
+    if (!m_recordLayers || !isVisited(target.x, target.y))
+        return path;
+
+    // iz sloja l vedno obstaja obiskan sosed v sloju l - 1; sosedje so v
+    // slojih l - 1, l ali l + 1, zato jih sloj po modulu 4 loči
+    const sf::Vector2i dirs[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    sf::Vector2i cur = target;
+    path.push_back(cur);
+    while (cur != m_source) {
+        const int prev = (layerMod4(cur.x, cur.y) + 3) & 3;
+        for (const auto& d : dirs) {
+            const sf::Vector2i n{cur.x + d.x, cur.y + d.y};
+            if (isVisited(n.x, n.y) && layerMod4(n.x, n.y) == prev) {
+                cur = n;
+                break;
+            }
+        }
+        path.push_back(cur);
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+FloodFillRunner::FloodFillRunner(const Grid& grid)
+    : m_grid(&grid),
+      m_fill(grid),
+      m_inPath(grid.cellCount(), 0)
+{
+    auto startOpt = grid.getStart();
+    auto endOpt   = grid.getEnd();
+
+    if (!startOpt || !endOpt) {
+        m_finished = true;
+        return;
+    }
+
+    reset(*startOpt, *endOpt);
+}
+
+void FloodFillRunner::reset(sf::Vector2i start, sf::Vector2i goal) {
+    for (const auto& p : m_path)
+        m_inPath[m_grid->cellIndex(p.x, p.y)] = 0;
+    m_path.clear();
+
+    m_finished = false;
+    m_pathFound = false;
+    m_pathLength = 0;
+    m_end = goal;
+    if (m_changes) m_changes->addAll();
+
+    // če je start ali end izven mreže ali na zidu ali sta v različnih
+    // komponentah, nima smisla iskati poti
+    if (!m_grid->connected(start, goal)) {
+        m_fill.reset({-1, -1});
+        m_openMaxSize = 0;
+        m_finished = true;
+        return;
+    }
+
+    m_fill.reset(start);
+    m_openMaxSize = m_fill.frontierSize();
+}
+
+bool FloodFillRunner::step() {
+    if (m_finished)
+        return true;
+
+    // stara fronta postane zaprta, nova je odprta
+    auto log = [&](int cell) { m_changes->add(cell); };
+    if (m_changes) m_fill.forEachFrontier(log);
+    const bool grew = m_fill.advance();
+    if (m_changes) m_fill.forEachFrontier(log);
+    m_openMaxSize = std::max(m_openMaxSize, m_fill.frontierSize());
+
+    if (m_fill.isVisited(m_end.x, m_end.y)) {
+        m_finished = true;
+        m_pathFound = true;
+        buildPath();
+        return true;
+    }
+
+    // fronta je prazna, poti ni
+    if (!grew) {
+        m_finished = true;
+        m_pathFound = false;
+        return true;
+    }
+
+    // v enem frame-u obdelamo en sloj
+    return false;
+}
+
+void FloodFillRunner::buildPath() {
+    // počistimo samo celice prejšnje poti
+    for (const auto& p : m_path) {
+        m_inPath[m_grid->cellIndex(p.x, p.y)] = 0;
+        if (m_changes) m_changes->add(m_grid->cellIndex(p.x, p.y));
+    }
+
+    m_path = m_fill.pathTo(m_end);
+    for (const auto& p : m_path) {
+        m_inPath[m_grid->cellIndex(p.x, p.y)] = 1;
+        if (m_changes) m_changes->add(m_grid->cellIndex(p.x, p.y));
+    }
+
+    m_pathLength = static_cast<int>(m_path.size());
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Grid.hpp"
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// BFS s poplavljanjem po bitsetu zidov. Fronta in obiskane celice so bitseti
+// z enako postavitvijo kot Grid (wordsPerRow() besed na vrstico, bit gx + 1),
+// en sloj (wavefront) pa razširimo po 64 celic naenkrat:
+//   nova = (F | F << 1 | F >> 1 | F zgoraj | F spodaj) & ~zid & ~obiskano
+// Obdelamo samo besede, ki imajo v fronti kaj nastavljenega, in njihove
+// sosede, zato tanka fronta v labirintu ne pregleduje cele mreže.
+//
+// Primerno za množična vprašanja "ali je B dosegljiv iz A in kako daleč"
+// (distance()). Za pot si vsak sloj zapišemo v dve bitni ravnini (sloj po
+// modulu 4, prav tako po 64 celic naenkrat); sosednji celici se v BFS
+// razlikujeta za največ 1 sloj, zato to zadošča za sledenje nazaj do izvora.
+class BitFloodFill {
+public:
+    using Word = Grid::Word;
+
+    explicit BitFloodFill(const Grid& grid);
+
+    // nov fill iz celice source (prejšnje stanje se zavrže); recordLayers
+    // določa, ali se sloji zapisujejo (potrebno za pathTo())
+    void reset(sf::Vector2i source, bool recordLayers = true);
+
+    // razširi fronto za en sloj; vrne false, ko je fronta prazna
+    bool advance();
+
+    // BFS razdalja (število korakov) od from do to ali -1, če to ni dosegljiv
+    int distance(sf::Vector2i from, sf::Vector2i to);
+
+    // ali je to dosegljiv iz from: indeks komponent mreže odgovori v O(1),
+    // brez poplavljanja (stanje filla ostane nespremenjeno)
+    bool reachable(sf::Vector2i from, sf::Vector2i to) const { return m_grid->connected(from, to); }
+
+    bool isVisited(int gx, int gy) const  { return testBit(m_visited, gx, gy); }
+    bool isFrontier(int gx, int gy) const { return testBit(m_frontier, gx, gy); }
+
+    // pot od izvora do target po slojih (prazna, če target ni obiskan)
+    std::vector<sf::Vector2i> pathTo(sf::Vector2i target) const;
+
+    int layerCount()   const { return m_layer; } // sloj trenutne fronte = razdalja
+    int visitedCount() const { return m_visitedCount; }
+    int frontierSize() const { return m_frontierSize; }
+
+    // f(cellIndex) za vsako celico fronte
+    template <class F>
+    void forEachFrontier(F&& f) const {
+        for (int w : m_active) {
+            Word bits = m_frontier[w];
+            while (bits) {
+                const int bit = (w % m_stride) * Grid::WordBits + std::countr_zero(bits);
+                bits &= bits - 1;
+                f(m_grid->cellIndex(bit - 1, w / m_stride - 2));
+            }
+        }
+    }
+
+private:
+    const Grid* m_grid = nullptr;
+    int m_cols = 0;
+    int m_rows = 0;
+    int m_stride = 0;
+
+    // bitseti po (gy + 2) * m_stride + beseda: kot Grid::wallRow(-1), z
+    // dodatno prazno vrstico nad in pod robom, da sosedov besed v advance()
+    // ni treba preverjati. Beseda w ustreza besedi zidu w - m_stride.
+    std::vector<Word> m_visited;
+    std::vector<Word> m_frontier;
+    std::vector<Word> m_next;
+
+    std::vector<int> m_active; // besede z nastavljeno fronto
+    std::vector<int> m_fresh;  // besede naslednje fronte
+
+    // sloj obiskane celice po modulu 4: bit 0 v m_layerLow, bit 1 v m_layerHigh
+    std::vector<Word> m_layerLow;
+    std::vector<Word> m_layerHigh;
+    bool m_recordLayers = true;
+    sf::Vector2i m_source{};
+
+    int m_layer = 0;
+    int m_visitedCount = 0;
+    int m_frontierSize = 0;
+
+    bool testBit(const std::vector<Word>& bits, int gx, int gy) const {
+        if (!m_grid->inBounds(gx, gy)) return false;
+        const int bit = gx + 1;
+        return (bits[wordIndex(gx, gy)] >> (bit % Grid::WordBits)) & 1u;
+    }
+
+    int layerMod4(int gx, int gy) const {
+        return testBit(m_layerLow, gx, gy) | testBit(m_layerHigh, gx, gy) << 1;
+    }
+
+    int wordIndex(int gx, int gy) const {
+        return (gy + 2) * m_stride + (gx + 1) / Grid::WordBits;
+    }
+
+    void spreadInto(int word, const Word* walls);
+};
+
+// Runner z istim vmesnikom kot SearchRunner: en step() je en sloj BFS.
+// Vsak korak stane 1, teren se ignorira (kot BFSRunner).
+class FloodFillRunner {
+public:
+    explicit FloodFillRunner(const Grid& grid);
+
+    // novo iskanje od start do goal na isti mreži (kot SearchRunner::reset)
+    void reset(sf::Vector2i start, sf::Vector2i goal);
+
+    // izvede en korak (razširi en sloj); vrne true, ko je algoritem končan
+    bool step();
+
+    // zapis spremenjenih celic za izris (kot SearchRunner::setChangeLog)
+    void setChangeLog(ChangeLog* log) { m_changes = log; }
+
+    bool isFinished() const { return m_finished; }
+    bool hasPath()    const { return m_pathFound; }
+
+    bool isOpen(int gx, int gy) const   { return m_fill.isFrontier(gx, gy); }
+    bool isClosed(int gx, int gy) const { return m_fill.isVisited(gx, gy) && !m_fill.isFrontier(gx, gy); }
+    bool isInPath(int gx, int gy) const {
+        return m_grid->inBounds(gx, gy) && m_inPath[m_grid->cellIndex(gx, gy)];
+    }
+
+    int getPathCost() const { return m_pathFound ? m_pathLength - 1 : -1; }
+
+    const std::vector<sf::Vector2i>& getPath() const { return m_path; }
+
+    // statistika za HUD
+    int getVisitedCount() const { return m_fill.visitedCount(); }
+    int getOpenMaxSize()  const { return m_openMaxSize; }
+    int getPathLength()   const { return m_pathLength;  }
+
+    static constexpr int INF = std::numeric_limits<int>::max();
+
+private:
+    // microbenchmark meri buildPath() posebej
+    friend struct RunnerBenchAccess;
+
+    const Grid* m_grid = nullptr;
+    BitFloodFill m_fill;
+    sf::Vector2i m_end{};
+
+    std::vector<std::uint8_t> m_inPath; // po Grid::cellIndex
+    std::vector<sf::Vector2i> m_path;
+    ChangeLog* m_changes = nullptr;
+
+    bool m_finished = false;
+    bool m_pathFound = false;
+
+    int m_openMaxSize = 0;
+    int m_pathLength  = 0;
+
+    void buildPath(); // sledenje slojev nazaj od cilja
+};
@@ -0,0 +1,304 @@
+#include "FlowField.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+FlowField::FlowField(const Grid& grid, int threads)
+    : m_grid(&grid),
+      m_tilesX((grid.getCols() + TileSize - 1) / TileSize),
+      m_tilesY((grid.getRows() + TileSize - 1) / TileSize),
+      m_dist(grid.cellCount(), Unreachable),
+      m_dir(grid.cellCount(), NoDirection)
+{
+    m_tiles.resize(static_cast<std::size_t>(m_tilesX) * m_tilesY);
+    for (int ty = 0; ty < m_tilesY; ++ty) {
+        for (int tx = 0; tx < m_tilesX; ++tx) {
+            Tile& t = m_tiles[ty * m_tilesX + tx];
+            t.x0 = tx * TileSize;
+            t.y0 = ty * TileSize;
+            t.x1 = std::min(t.x0 + TileSize, grid.getCols()) - 1;
+            t.y1 = std::min(t.y0 + TileSize, grid.getRows()) - 1;
+        }
+    }
+    m_touched.assign(m_tiles.size(), 0);
+
+    m_pool = std::make_unique<ThreadPool>(threads);
+    m_heaps.resize(m_pool->size());
+}
+
+FlowField::~FlowField() = default;
+
+int FlowField::threadCount() const {
+    return m_pool->size();
+}
+
+void FlowField::build(std::span<const sf::Vector2i> goals) {
+    std::fill(m_dist.begin(), m_dist.end(), Unreachable);
+    std::fill(m_dir.begin(), m_dir.end(), NoDirection);
+    for (Tile& t : m_tiles) {
+        t.dirty = false;
+        t.changedSides = 0;
+        t.seeds.clear();
+    }
+
+    m_goals.clear();
+    for (const sf::Vector2i& g : goals) {
+        if (!m_grid->inBounds(g.x, g.y))
+            continue;
+        m_goals.push_back(g);
+        if (m_grid->isWall(g.x, g.y))
+            continue; // postane aktiven, ko ga update() vidi odprtega
+        const int cell = m_grid->cellIndex(g.x, g.y);
+        m_dist[cell] = 0;
+        addSeed(cell);
+    }
+
+    std::fill(m_touched.begin(), m_touched.end(), std::uint8_t{0});
+    relaxDirtyTiles();
+
+    // smeri za vse ploščice
+    std::vector<std::uint8_t> all(m_tiles.size(), 1);
+    computeDirectionsAround(all);
+}
+
+void FlowField::update(std::span<const sf::Vector2i> changed) {
+    const int w = m_grid->paddedCols();
+    const int offsets[4] = {1, -1, w, -w};
+
+    auto isGoal = [&](sf::Vector2i p) {
+        return std::find(m_goals.begin(), m_goals.end(), p) != m_goals.end();
+    };
+
+    // 1) razveljavimo celice, katerih tok gre skozi spremenjeno celico
+    //    (poddrevo po kazalcih smeri); kazalci še neobiskanih celic so cele
+    std::vector<int> invalidated;
+    std::vector<int> stack;
+    for (const sf::Vector2i& p : changed) {
+        if (!m_grid->inBounds(p.x, p.y))
+            continue;
+
+        const int root = m_grid->cellIndex(p.x, p.y);
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const int cur = stack.back();
+            stack.pop_back();
+            for (int d = 0; d < 4; ++d) {
+                const int n = cur - offsets[d];
+                if (m_dir[n] == d) { // n gre v smeri d, torej v cur
+                    m_dir[n] = NoDirection;
+                    m_dist[n] = Unreachable;
+                    invalidated.push_back(n);
+                    stack.push_back(n);
+                }
+            }
+        }
+
+        m_dir[root] = NoDirection;
+        m_dist[root] = (isGoal(p) && !m_grid->isWall(p.x, p.y)) ? 0 : Unreachable;
+        invalidated.push_back(root);
+    }
+
+    // 2) semena so veljavni sosedje razveljavljenih celic (in odprti cilji)
+    std::fill(m_touched.begin(), m_touched.end(), std::uint8_t{0});
+    for (int cell : invalidated) {
+        const sf::Vector2i pos = m_grid->cellPos(cell);
+        if (m_grid->isWall(pos.x, pos.y))
+            continue;
+        if (m_dist[cell] == 0)
+            addSeed(cell);
+
+        unsigned open = m_grid->openNeighbors4(pos.x, pos.y);
+        while (open) {
+            const int d = std::countr_zero(open);
+            open &= open - 1;
+            const int n = cell + offsets[d];
+            if (m_dist[n] != Unreachable)
+                addSeed(n);
+        }
+        // ploščica razveljavljene celice mora na robu povleči vrednosti sosedov
+        m_tiles[tileOf(pos.x, pos.y)].dirty = true;
+    }
+
+    relaxDirtyTiles();
+    computeDirectionsAround(m_touched);
+}
+
+void FlowField::addSeed(int cell) {
+    const sf::Vector2i pos = m_grid->cellPos(cell);
+    Tile& t = m_tiles[tileOf(pos.x, pos.y)];
+    t.seeds.push_back(cell);
+    t.dirty = true;
+}
+
+void FlowField::relaxDirtyTiles() {
+    m_tilesProcessed = 0;
+    std::vector<int> batch;
+
+    const std::function<void(int, int)> job = [&](int worker, int i) {
+        processTile(m_tiles[batch[i]], m_heaps[worker]);
+    };
+
+    for (bool any = true; any;) {
+        any = false;
+        for (int color = 0; color < 2; ++color) {
+            batch.clear();
+            for (int ty = 0; ty < m_tilesY; ++ty) {
+                for (int tx = (ty + color) & 1; tx < m_tilesX; tx += 2) {
+                    Tile& t = m_tiles[ty * m_tilesX + tx];
+                    if (t.dirty) {
+                        t.dirty = false;
+                        batch.push_back(ty * m_tilesX + tx);
+                    }
+                }
+            }
+            if (batch.empty())
+                continue;
+            any = true;
+
+            m_pool->parallelFor(static_cast<int>(batch.size()), job);
+            m_tilesProcessed += static_cast<int>(batch.size());
+
+            // sosedi spremenjenih robov morajo povleči nove vrednosti
+            for (int idx : batch) {
+                Tile& t = m_tiles[idx];
+                m_touched[idx] = 1;
+                const int tx = idx % m_tilesX;
+                const int ty = idx / m_tilesX;
+                if ((t.changedSides & 1) && tx + 1 < m_tilesX) m_tiles[idx + 1].dirty = true;
+                if ((t.changedSides & 2) && tx > 0)             m_tiles[idx - 1].dirty = true;
+                if ((t.changedSides & 4) && ty + 1 < m_tilesY) m_tiles[idx + m_tilesX].dirty = true;
+                if ((t.changedSides & 8) && ty > 0)             m_tiles[idx - m_tilesX].dirty = true;
+                t.changedSides = 0;
+            }
+        }
+    }
+}
+
+// Lokalna Dijkstra znotraj ploščice: začne iz semen in iz robnih celic, ki
+// jim sosednja ploščica ponuja boljšo ceno. d(v) = min(cost(u) + d(u)) po
+// sosedih u, ker premik v -> u stane teren celice u.
+void FlowField::processTile(Tile& tile, std::vector<HeapEntry>& heap) {
+    const Grid& grid = *m_grid;
+    const int w = grid.paddedCols();
+    const int offsets[4] = {1, -1, w, -w};
+
+    auto cmp = [](const HeapEntry& a, const HeapEntry& b) { return a.dist > b.dist; };
+    auto push = [&](int dist, int cell) {
+        heap.push_back(HeapEntry{dist, cell});
+        std::push_heap(heap.begin(), heap.end(), cmp);
+    };
+
+    heap.clear();
+    for (int cell : tile.seeds)
+        if (m_dist[cell] != Unreachable)
+            push(m_dist[cell], cell);
+    tile.seeds.clear();
+
+    // vrednosti z roba sosednjih ploščic (te v tej fazi ne tečejo)
+    auto pull = [&](int gx, int gy, int d) {
+        if (grid.isWall(gx, gy))
+            return;
+        const int cell = grid.cellIndex(gx, gy);
+        const int outside = cell + offsets[d];
+        if (m_dist[outside] == Unreachable)
+            return;
+        const int cand = m_dist[outside] + grid.costAt(outside);
+        if (cand < m_dist[cell]) {
+            m_dist[cell] = cand;
+            push(cand, cell);
+        }
+    };
+    for (int x = tile.x0; x <= tile.x1; ++x) {
+        if (tile.y0 > 0)                   pull(x, tile.y0, 3);
+        if (tile.y1 < grid.getRows() - 1)  pull(x, tile.y1, 2);
+    }
+    for (int y = tile.y0; y <= tile.y1; ++y) {
+        if (tile.x0 > 0)                   pull(tile.x0, y, 1);
+        if (tile.x1 < grid.getCols() - 1)  pull(tile.x1, y, 0);
+    }
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        const HeapEntry top = heap.back();
+        heap.pop_back();
+        if (top.dist != m_dist[top.cell])
+            continue; // zastarel zapis
+
+        const sf::Vector2i pos = grid.cellPos(top.cell);
+
+        // ustaljena robna celica: sosednja ploščica naj jo prebere
+        if (pos.x == tile.x1) tile.changedSides |= 1;
+        if (pos.x == tile.x0) tile.changedSides |= 2;
+        if (pos.y == tile.y1) tile.changedSides |= 4;
+        if (pos.y == tile.y0) tile.changedSides |= 8;
+
+        const int cand = top.dist + grid.costAt(top.cell);
+        unsigned open = grid.openNeighbors4(pos.x, pos.y);
+        while (open) {
+            const int d = std::countr_zero(open);
+            open &= open - 1;
+
+            const int nx = pos.x + Dirs[d].x;
+            const int ny = pos.y + Dirs[d].y;
+            if (nx < tile.x0 || nx > tile.x1 || ny < tile.y0 || ny > tile.y1)
+                continue;
+
+            const int n = top.cell + offsets[d];
+            if (cand < m_dist[n]) {
+                m_dist[n] = cand;
+                push(cand, n);
+            }
+        }
+    }
+}
+
+// smer vsake celice je prvi sosed (v vrstnem redu Dirs) na najcenejši poti
+void FlowField::computeDirections(const Tile& tile) {
+    const Grid& grid = *m_grid;
+    const int w = grid.paddedCols();
+    const int offsets[4] = {1, -1, w, -w};
+
+    for (int y = tile.y0; y <= tile.y1; ++y) {
+        for (int x = tile.x0; x <= tile.x1; ++x) {
+            const int cell = grid.cellIndex(x, y);
+            m_dir[cell] = NoDirection;
+
+            const int dist = m_dist[cell];
+            if (dist == Unreachable || dist == 0)
+                continue;
+
+            unsigned open = grid.openNeighbors4(x, y);
+            while (open) {
+                const int d = std::countr_zero(open);
+                open &= open - 1;
+                const int n = cell + offsets[d];
+                if (m_dist[n] != Unreachable && m_dist[n] + grid.costAt(n) == dist) {
+                    m_dir[cell] = static_cast<std::uint8_t>(d);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// smeri za označene ploščice in njihove sosede (robne celice sosedov lahko
+// zdaj kažejo v spremenjeno ploščico)
+void FlowField::computeDirectionsAround(const std::vector<std::uint8_t>& tiles) {
+    std::vector<int> batch;
+    for (int ty = 0; ty < m_tilesY; ++ty) {
+        for (int tx = 0; tx < m_tilesX; ++tx) {
+            auto marked = [&](int x, int y) {
+                return x >= 0 && x < m_tilesX && y >= 0 && y < m_tilesY && tiles[y * m_tilesX + x];
+            };
+            if (marked(tx, ty) || marked(tx - 1, ty) || marked(tx + 1, ty) ||
+                marked(tx, ty - 1) || marked(tx, ty + 1))
+                batch.push_back(ty * m_tilesX + tx);
+        }
+    }
+
+    m_pool->parallelFor(static_cast<int>(batch.size()), [&](int, int i) {
+        computeDirections(m_tiles[batch[i]]);
+    });
+}
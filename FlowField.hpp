@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Grid.hpp"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+class ThreadPool;
+
+// Flow field: za vse celice mreže naenkrat izračuna ceno do najbližjega
+// cilja in smer naslednjega koraka, tako da lahko poljubno število enot
+// svoj naslednji premik prebere v O(1). Cena je ista kot pri TerrainCost
+// (vstop v celico stane njen teren), premiki so 4-sosedski.
+//
+// Mreža je razdeljena na ploščice TileSize x TileSize. Ploščica, ki ima nove
+// vrednosti na robu ali nova semena, požene lokalno Dijkstro; to se ponavlja,
+// dokler se nič ne spremeni. Ploščice so pobarvane kot šahovnica in ena barva
+// teče vzporedno, zato sosednji ploščici nikoli ne tečeta hkrati (vsaka piše
+// samo v svoje celice, bere pa robove sosedov).
+//
+// Po spremembah mreže (setWall, clearCell, setCost) update() razveljavi samo
+// celice, katerih tok gre skozi spremenjene celice, in jih izračuna znova.
+class FlowField {
+public:
+    static constexpr int TileSize = 64;
+    static constexpr int Unreachable = std::numeric_limits<int>::max();
+
+    // threads = 0 pomeni std::thread::hardware_concurrency()
+    explicit FlowField(const Grid& grid, int threads = 0);
+    ~FlowField();
+
+    FlowField(const FlowField&) = delete;
+    FlowField& operator=(const FlowField&) = delete;
+
+    // celoten izračun za dane cilje (cilj na zidu velja, ko je celica spet prosta)
+    void build(std::span<const sf::Vector2i> goals);
+
+    // ponoven izračun po spremembi celic changed (zid, teren) na isti mreži
+    void update(std::span<const sf::Vector2i> changed);
+
+    // cena do najbližjega cilja ali Unreachable
+    int distance(int gx, int gy) const {
+        if (!m_grid->inBounds(gx, gy)) return Unreachable;
+        return m_dist[m_grid->cellIndex(gx, gy)];
+    }
+
+    // naslednji korak (eden od 4 sosedov); {0, 0} na cilju ali če cilj ni dosegljiv
+    sf::Vector2i direction(int gx, int gy) const {
+        if (!m_grid->inBounds(gx, gy)) return {0, 0};
+        const std::uint8_t dir = m_dir[m_grid->cellIndex(gx, gy)];
+        return dir == NoDirection ? sf::Vector2i{0, 0} : Dirs[dir];
+    }
+
+    const std::vector<sf::Vector2i>& getGoals() const { return m_goals; }
+
+    int threadCount()    const;
+    int tilesProcessed() const { return m_tilesProcessed; } // v zadnjem build()/update()
+
+private:
+    static constexpr std::uint8_t NoDirection = 0xFF;
+
+    // vrstni red kot Neighbors4 / Grid::openNeighbors4
+    static constexpr sf::Vector2i Dirs[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+    struct Tile {
+        int x0 = 0, y0 = 0; // prva celica
+        int x1 = 0, y1 = 0; // zadnja celica (vključno)
+        bool dirty = false;
+        std::uint8_t changedSides = 0; // robovi z novimi vrednostmi (biti kot Dirs)
+        std::vector<int> seeds;        // celice, iz katerih naj lokalna Dijkstra začne
+    };
+
+    struct HeapEntry {
+        int dist;
+        int cell;
+    };
+
+    const Grid* m_grid = nullptr;
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+
+    std::vector<int> m_dist;          // po Grid::cellIndex
+    std::vector<std::uint8_t> m_dir;  // indeks v Dirs ali NoDirection
+    std::vector<sf::Vector2i> m_goals;
+
+    std::vector<Tile> m_tiles;
+    std::vector<std::uint8_t> m_touched;         // ploščica je bila obdelana v tem prehodu
+    std::vector<std::vector<HeapEntry>> m_heaps; // ena kopica na nit
+    std::unique_ptr<ThreadPool> m_pool;
+
+    int m_tilesProcessed = 0;
+
+    int tileOf(int gx, int gy) const { return (gy / TileSize) * m_tilesX + gx / TileSize; }
+
+    void addSeed(int cell);
+    void relaxDirtyTiles();
+    void processTile(Tile& tile, std::vector<HeapEntry>& heap);
+    void computeDirections(const Tile& tile);
+    void computeDirectionsAround(const std::vector<std::uint8_t>& tiles);
+};
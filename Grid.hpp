@@ -1,17 +1,52 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
+#include "ChangeLog.hpp"
+#include "ThreadPool.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 #include <random>
+#include <utility>
+
+// Algoritmi za Grid::generateMaze(). Vsi naredijo popoln labirint (med
+// vsakima celicama natanko ena pot) na celicah z lihima koordinatama.
+enum class MazeAlgorithm {
+    Backtracker, // DFS, dolgi vijugasti hodniki
+    Eller,       // po vrsticah s pomnilnikom O(cols), za zelo velike labirinte
+    Kruskal,     // naključni vrstni red sten z union-find
+    Wilson       // enakomerno naključno vpeto drevo (loop-erased random walk)
+};
 
 class Grid {
 public:
+    // Zidovi so shranjeni kot en strnjen bitset. Vsaka vrstica zaseda
+    // wordsPerRow() 64-bitnih besed, celica (gx, gy) je bit (gx + 1) vrstice gy.
+    // Okoli mreže je en pas zidov (sentinel), poravnalni biti na koncu vrstice
+    // so prav tako zid, zato isWall() velja tudi za gx = -1 / m_cols in
+    // gy = -1 / m_rows in runnerjem ni treba preverjati meja.
+    using Word = std::uint64_t;
+    static constexpr int WordBits = 64;
+
     Grid(int cols, int rows, int cellSize)
-        : m_cols(cols),
-          m_rows(rows),
-          m_cellSize(cellSize),
-          m_walls(rows, std::vector<bool>(cols, false)) {}
+        : Grid(cols, rows, cellSize, Storage{})
+    {
+        fillWalls(false);
+    }
+
+    // mreža iz zidov in cen, kot pri assignCells(), brez vmesne prazne mreže
+    // (nalaganje, GridFile.hpp)
+    Grid(int cols, int rows, int cellSize, const Word* walls, const std::uint8_t* costs)
+        : Grid(cols, rows, cellSize, Storage{})
+    {
+        assignCells(walls, costs);
+    }
 
     int getCols() const { return m_cols; }
     int getRows() const { return m_rows; }
@@ -21,29 +56,205 @@ public:
         return gx >= 0 && gx < m_cols && gy >= 0 && gy < m_rows;
     }
 
-    // zidovi
+    // zidovi; gx v [-1, m_cols], gy v [-1, m_rows] (rob je vedno zid)
     bool isWall(int gx, int gy) const {
-        return m_walls[gy][gx];
+        const int bit = gx + 1;
+        return (wallRow(gy)[bit / WordBits] >> (bit % WordBits)) & 1u;
     }
 
     void setWall(int gx, int gy, bool value) {
         if (!inBounds(gx, gy)) return;
-        m_walls[gy][gx] = value;
+        writeWall(gx, gy, value);
+    }
+
+    // indeks celice v ravnih poljih z robom: (gx + 1) + (gy + 1) * paddedCols();
+    // sosedje so na +-1 in +-paddedCols(), celice roba imajo veljaven indeks
+    int paddedCols() const { return m_cols + 2; }
+    int cellCount()  const { return (m_cols + 2) * (m_rows + 2); }
+
+    int cellIndex(int gx, int gy) const {
+        return (gy + 1) * (m_cols + 2) + (gx + 1);
+    }
+
+    sf::Vector2i cellPos(int index) const {
+        return sf::Vector2i{index % (m_cols + 2) - 1, index / (m_cols + 2) - 1};
+    }
+
+    // teren: cena prehoda v celico (1 = običajno, do 255 = zelo drago);
+    // zidovi so neodvisni od cene
+    static constexpr int MinCost = 1;
+    static constexpr int MaxCost = 255;
+
+    int getCost(int gx, int gy) const {
+        if (!inBounds(gx, gy)) return MinCost;
+        return m_costs[cellIndex(gx, gy)];
+    }
+
+    void setCost(int gx, int gy, int cost) {
+        if (!inBounds(gx, gy)) return;
+        const auto value = static_cast<std::uint8_t>(std::clamp(cost, MinCost, MaxCost));
+        std::uint8_t& c = m_costs[cellIndex(gx, gy)];
+        if (c != value) {
+            m_changes.add(cellIndex(gx, gy));
+            ++m_epoch;
+        }
+        c = value;
     }
 
+    // cena po indeksu celice (Grid::cellIndex), brez preverjanja
+    int costAt(int index) const { return m_costs[index]; }
+
+    // surovi dostop do cen: cellCount() bajtov po cellIndex()
+    const std::uint8_t* costData() const { return m_costs.data(); }
+
+    // surovi dostop do bitseta: število besed v vrstici in kazalec na vrstico gy
+    // (gy v [-1, m_rows]); bit (gx + 1) je celica gx
+    int wordsPerRow() const { return m_stride; }
+
+    const Word* wallRow(int gy) const {
+        return m_walls.data() + static_cast<std::size_t>(gy + 1) * m_stride;
+    }
+
+    // ali so vse celice od x0 do x1 (vključno) v vrstici gy proste;
+    // x0, x1 v [-1, m_cols], vrstni red ni pomemben
+    bool rowSpanOpen(int gy, int x0, int x1) const {
+        if (x0 > x1) std::swap(x0, x1);
+        const Word* row = wallRow(gy);
+        const int b0 = x0 + 1;
+        const int b1 = x1 + 1;
+        for (int w = b0 / WordBits; w <= b1 / WordBits; ++w) {
+            Word mask = ~Word{0};
+            if (w == b0 / WordBits) mask &= ~Word{0} << (b0 % WordBits);
+            if (w == b1 / WordBits) mask &= ~Word{0} >> (WordBits - 1 - b1 % WordBits);
+            if (row[w] & mask) return false;
+        }
+        return true;
+    }
+
+    // maska prostih 4-sosedov celice (gx, gy) brez preverjanja meja;
+    // bit 0 = (+1, 0), bit 1 = (-1, 0), bit 2 = (0, +1), bit 3 = (0, -1)
+    unsigned openNeighbors4(int gx, int gy) const {
+        const int bit = gx + 1;
+        const Word* row = wallRow(gy);
+        const Word* up  = row - m_stride;
+        const Word* dn  = row + m_stride;
+        const int w = bit / WordBits;
+        const int o = bit % WordBits;
+
+        unsigned walls =
+            static_cast<unsigned>((row[(bit + 1) / WordBits] >> ((bit + 1) % WordBits)) & 1u)
+          | static_cast<unsigned>((row[(bit - 1) / WordBits] >> ((bit - 1) % WordBits)) & 1u) << 1
+          | static_cast<unsigned>((dn[w] >> o) & 1u) << 2
+          | static_cast<unsigned>((up[w] >> o) & 1u) << 3;
+        return ~walls & 0xFu;
+    }
+
+    // Maska prostih 8-sosedov; bit d je prost sosed v smeri d: 0..3 kot
+    // openNeighbors4, nato (+1, +1), (-1, -1), (+1, -1), (-1, +1), tako da
+    // sta nasprotni smeri vedno d in d ^ 1. Maske so predizračunane po
+    // cellIndex(), zato 8-sosedska soseščina prebere en bajt namesto osmih
+    // bitov iz treh vrstic. Zgradijo se ob prvi 8-sosedski poizvedbi, nato
+    // jih vsak zapis zidu popravi; clearAll, generateMaze in assignCells jih
+    // samo označijo za ponovno gradnjo, zato mreže brez 8-sosedskih iskanj
+    // nanje ne čakajo.
+    unsigned openNeighbors8(int gx, int gy) const {
+        refreshNeighborMasks();
+        return m_neighborMasks[cellIndex(gx, gy)];
+    }
+
+    // brez preverjanja: velja po refreshNeighborMasks() (Neighbors8::prepare)
+    unsigned neighborMask8(int cell) const { return m_neighborMasks[cell]; }
+
+    // zgradi zastarele maske; neighborMask8() je potem samo branje in ga
+    // lahko hkrati kliče več niti (dokler se mreža ne spremeni v celoti)
+    void refreshNeighborMasks() const {
+        if (!m_neighborMasksDirty)
+            return;
+        m_neighborMasks.resize(static_cast<std::size_t>(cellCount()));
+        rebuildNeighborMasks(0, m_rows);
+        m_neighborMasksDirty = false;
+    }
+
+    // Vsi zidovi in cene naenkrat (nalaganje iz datoteke, GridFile.hpp):
+    // walls je (rows + 2) * wordsPerRow() besed v obliki wallRow(-1 .. rows),
+    // costs je cellCount() cen po cellIndex() ali nullptr (vse MinCost).
+    // Rob ostane zid ne glede na vsebino, start in end se odstranita.
+    void assignCells(const Word* walls, const std::uint8_t* costs) {
+        std::copy(walls, walls + m_walls.size(), m_walls.begin());
+
+        // biti roba in poravnave vrstice: bit 0 in vse za m_cols
+        std::vector<Word> border(m_stride, 0);
+        border[0] |= Word{1};
+        for (int bit = m_cols + 1; bit < m_stride * WordBits; ++bit)
+            border[bit / WordBits] |= Word{1} << (bit % WordBits);
+        std::fill(wallRowMut(-1), wallRowMut(0), ~Word{0});
+        std::fill(wallRowMut(m_rows), wallRowMut(m_rows) + m_stride, ~Word{0});
+        for (int gy = 0; gy < m_rows; ++gy) {
+            Word* row = wallRowMut(gy);
+            for (int w = 0; w < m_stride; ++w)
+                row[w] |= border[w];
+        }
+
+        if (costs) {
+            std::transform(costs, costs + m_costs.size(), m_costs.begin(),
+                           [](std::uint8_t c) { return std::max<std::uint8_t>(c, MinCost); });
+        } else {
+            std::fill(m_costs.begin(), m_costs.end(), std::uint8_t{MinCost});
+        }
+
+        m_start.reset();
+        m_end.reset();
+        m_neighborMasksDirty = true;
+        m_componentsDirty = true;
+        m_changes.addAll();
+        ++m_epoch;
+    }
+
+    // Povezane komponente (4-sosedstvo) za takojšnjo zavrnitev nedosegljivih
+    // poizvedb: ali sta a in b prosti celici v isti komponenti. Indeks se
+    // zgradi ob prvi poizvedbi; odstranjen zid komponenti samo združi, nov zid
+    // pa indeks zavrže le, če bi lahko razdelil komponento (takrat se ob
+    // naslednji poizvedbi zgradi znova v O(N)). Sicer je poizvedba O(1).
+    bool connected(sf::Vector2i a, sf::Vector2i b) const {
+        if (!inBounds(a.x, a.y) || !inBounds(b.x, b.y) || isWall(a.x, a.y) || isWall(b.x, b.y))
+            return false;
+        refreshComponents();
+        return componentRoot(componentNode(cellIndex(a.x, a.y))) ==
+               componentRoot(componentNode(cellIndex(b.x, b.y)));
+    }
+
+    // zgradi zastarel indeks komponent; connected() je potem samo branje in
+    // ga lahko hkrati kliče več niti (dokler se mreža ne spremeni)
+    void refreshComponents() const {
+        if (m_componentsDirty)
+            rebuildComponents();
+    }
+
+    // celice, ki so se spremenile od zadnjega changes().clear() (za izris)
+    ChangeLog& changes() { return m_changes; }
+
+    // Števec urejanj: poveča se ob vsaki spremembi zidu ali cene (setWall,
+    // clearCell, setCost, clearAll, generateMaze, assignCells), start in end
+    // ga ne spremenita. Rezultat iskanja z istim epoch je še veljaven (PathCache).
+    std::uint64_t epoch() const { return m_epoch; }
+
     // start / end
     void setStart(int gx, int gy) {
         if (!inBounds(gx, gy)) return;
-        m_walls[gy][gx] = false;
+        writeWall(gx, gy, false);
+        clearStart();
         m_start = sf::Vector2i{gx, gy};
+        m_changes.add(cellIndex(gx, gy));
         if (m_end && *m_end == *m_start)
             m_end.reset();
     }
 
     void setEnd(int gx, int gy) {
         if (!inBounds(gx, gy)) return;
-        m_walls[gy][gx] = false;
+        writeWall(gx, gy, false);
+        clearEnd();
         m_end = sf::Vector2i{gx, gy};
+        m_changes.add(cellIndex(gx, gy));
         if (m_start && *m_start == *m_end)
             m_start.reset();
     }
@@ -62,48 +273,63 @@ public:
         return m_end && m_end->x == gx && m_end->y == gy;
     }
 
-    void clearStart() { m_start.reset(); }
-    void clearEnd()   { m_end.reset();   }
+    void clearStart() {
+        if (m_start) m_changes.add(cellIndex(m_start->x, m_start->y));
+        m_start.reset();
+    }
+    void clearEnd() {
+        if (m_end) m_changes.add(cellIndex(m_end->x, m_end->y));
+        m_end.reset();
+    }
 
     void clearCell(int gx, int gy) {
         if (!inBounds(gx, gy)) return;
-        m_walls[gy][gx] = false;
+        writeWall(gx, gy, false);
+        setCost(gx, gy, MinCost);
         if (isStart(gx, gy)) clearStart();
         if (isEnd(gx, gy))   clearEnd();
     }
 
-    // počisti vse zidove in odstrani start/end
+    // počisti vse zidove in teren ter odstrani start/end
     void clearAll() {
-        for (int y = 0; y < m_rows; ++y)
-            for (int x = 0; x < m_cols; ++x)
-                m_walls[y][x] = false;
+        fillWalls(false);
+        std::fill(m_costs.begin(), m_costs.end(), std::uint8_t{MinCost});
 
         clearStart();
         clearEnd();
     }
 
-    // preslikava med (gx, gy) in piksel koordinatami
+    // Preslikava med (gx, gy) in svetovnimi koordinatami (celica je
+    // cellSize x cellSize enot). Piksel okna je treba najprej preslikati s
+    // pogledom kamere, npr. window.mapPixelToCoords(pixel, view).
     sf::Vector2f cellToWorld(int gx, int gy) const {
         return sf::Vector2f{
-            static_cast<float>(gx * m_cellSize),
-            static_cast<float>(gy * m_cellSize)
+            static_cast<float>(gx) * static_cast<float>(m_cellSize),
+            static_cast<float>(gy) * static_cast<float>(m_cellSize)
         };
     }
 
-    std::optional<sf::Vector2i> worldToCell(const sf::Vector2i& pixelPos) const {
-        int gx = pixelPos.x / m_cellSize;
-        int gy = pixelPos.y / m_cellSize;
+    std::optional<sf::Vector2i> worldToCell(const sf::Vector2f& worldPos) const {
+        // floor, da točke levo/nad mrežo ne padejo v celico 0
+        const int gx = static_cast<int>(std::floor(worldPos.x / static_cast<float>(m_cellSize)));
+        const int gy = static_cast<int>(std::floor(worldPos.y / static_cast<float>(m_cellSize)));
         if (!inBounds(gx, gy))
             return std::nullopt;
         return sf::Vector2i{gx, gy};
     }
 
-    // generiranje labirinta z DFS (recursive backtracker, iterativno)
-    void generateMaze() {
+    // naključen labirint (seed iz random_device)
+    void generateMaze(MazeAlgorithm algorithm = MazeAlgorithm::Backtracker) {
+        generateMaze(std::random_device{}(), algorithm);
+    }
+
+    // isti labirint za isti seed in algoritem (za benchmarke). Generatorji
+    // pišejo neposredno v bitset zidov; fillWalls() je že zapisal addAll()
+    // in označil komponente in maske sosedov za ponovno gradnjo.
+    void generateMaze(std::uint32_t seed,
+                      MazeAlgorithm algorithm = MazeAlgorithm::Backtracker) {
         // začnemo z "polnim" zidom
-        for (int y = 0; y < m_rows; ++y)
-            for (int x = 0; x < m_cols; ++x)
-                m_walls[y][x] = true;
+        fillWalls(true);
 
         clearStart();
         clearEnd();
@@ -117,86 +343,667 @@ public:
             return;
         }
 
+        std::mt19937 rng{seed};
+        carveMaze(rng, algorithm, MazeArea{0, 0, mazeCols, mazeRows});
+
+        // start in end nastavimo v dva kota labirinta
+        int sx = 1;
+        int sy = 1;
+        int ex = 2 * (mazeCols - 1) + 1;
+        int ey = 2 * (mazeRows - 1) + 1;
+
+        if (inBounds(sx, sy)) setStart(sx, sy);
+        if (inBounds(ex, ey)) setEnd(ex, ey);
+    }
+
+    // Vzporedno generiranje velikih labirintov. Labirint razdelimo na
+    // ploščice tile x tile celic labirinta in v vsaki neodvisno zgradimo
+    // popoln labirint z izbranim algoritmom (seed ploščice je izpeljan iz
+    // seed in njenega indeksa). Ploščice nato povežemo z naključnim vpetim
+    // drevesom nad mrežo ploščic, z enim prehodom na skupnem robu za vsako
+    // povezavo drevesa, zato je rezultat spet popoln labirint. Razdelitev je
+    // odvisna samo od velikosti in tile, zato je labirint za isti seed enak
+    // pri vsakem številu niti v pool (ni pa enak netlakovanemu).
+    //
+    // Sosednja stolpca ploščic si lahko delita besedo bitseta, zato sode in
+    // lihe stolpce gradimo v dveh fazah; tile mora biti vsaj MinMazeTile, da
+    // si ploščici dva stolpca narazen nikoli ne delita besede.
+    static constexpr int MinMazeTile = 32;
+    static constexpr int DefaultMazeTile = 128;
+
+    void generateMaze(std::uint32_t seed, MazeAlgorithm algorithm, ThreadPool& pool,
+                      int tile = DefaultMazeTile) {
+        tile = std::max(tile, MinMazeTile);
+
+        fillWalls(true);
+
+        clearStart();
+        clearEnd();
+
+        const int mazeCols = (m_cols - 1) / 2;
+        const int mazeRows = (m_rows - 1) / 2;
+
+        if (mazeCols <= 0 || mazeRows <= 0) {
+            clearAll();
+            return;
+        }
+
+        const int tilesX = (mazeCols + tile - 1) / tile;
+        const int tilesY = (mazeRows + tile - 1) / tile;
+        auto tileArea = [&](int tx, int ty) {
+            return MazeArea{tx * tile, ty * tile,
+                            std::min(tile, mazeCols - tx * tile),
+                            std::min(tile, mazeRows - ty * tile)};
+        };
+
+        for (int phase = 0; phase < 2; ++phase) {
+            const int columns = (tilesX - phase + 1) / 2; // tx = phase, phase + 2, ...
+            pool.parallelFor(columns * tilesY, [&](int /*worker*/, int i) {
+                const int tx = phase + 2 * (i % columns);
+                const int ty = i / columns;
+                std::mt19937 rng{mixSeed(seed, ty * tilesX + tx)};
+                carveMaze(rng, algorithm, tileArea(tx, ty));
+            });
+        }
+
+        // vpeto drevo nad ploščicami (Kruskal); povezava = 2 * ploščica + (0 desno, 1 spodaj)
+        std::mt19937 rng{seed};
+        const int tiles = tilesX * tilesY;
+        std::vector<int> edges;
+        edges.reserve(2 * static_cast<std::size_t>(tiles));
+        for (int t = 0; t < tiles; ++t) {
+            if (t % tilesX + 1 < tilesX) edges.push_back(2 * t);
+            if (t / tilesX + 1 < tilesY) edges.push_back(2 * t + 1);
+        }
+        for (std::size_t i = edges.size(); i > 1; --i)
+            std::swap(edges[i - 1], edges[randomBelow(rng, static_cast<int>(i))]);
+
+        std::vector<int> parent(tiles);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&](int x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]];
+                x = parent[x];
+            }
+            return x;
+        };
+
+        const MazeArea whole{0, 0, mazeCols, mazeRows};
+        for (int e : edges) {
+            const int t = e >> 1;
+            const bool down = e & 1;
+            const int a = find(t);
+            const int b = find(t + (down ? tilesX : 1));
+            if (a == b)
+                continue;
+            parent[b] = a;
+
+            // prehod na naključnem mestu skupnega roba
+            const MazeArea area = tileArea(t % tilesX, t / tilesX);
+            if (down)
+                carveMazePassage(whole, area.x0 + randomBelow(rng, area.cols),
+                                 area.y0 + area.rows - 1, 0, 1);
+            else
+                carveMazePassage(whole, area.x0 + area.cols - 1,
+                                 area.y0 + randomBelow(rng, area.rows), 1, 0);
+        }
+
+        if (inBounds(1, 1)) setStart(1, 1);
+        const int ex = 2 * (mazeCols - 1) + 1;
+        const int ey = 2 * (mazeRows - 1) + 1;
+        if (inBounds(ex, ey)) setEnd(ex, ey);
+    }
+
+private:
+    struct Storage {};
+
+    // samo alokacija; vsebino zapiše fillWalls() ali assignCells()
+    Grid(int cols, int rows, int cellSize, Storage)
+        : m_cols(cols),
+          m_rows(rows),
+          m_cellSize(cellSize),
+          m_stride((cols + 2 + WordBits - 1) / WordBits),
+          m_walls(static_cast<std::size_t>(rows + 2) * m_stride, 0),
+          m_costs(static_cast<std::size_t>(cols + 2) * (rows + 2), 1)
+    {
+    }
+
+    int m_cols;
+    int m_rows;
+    int m_cellSize;
+    int m_stride; // besed na vrstico (vključno z robom)
+
+    std::vector<Word> m_walls; // (m_rows + 2) * m_stride besed
+    std::vector<std::uint8_t> m_costs; // cena po cellIndex()
+    // openNeighbors8 po cellIndex(); prazno do prve refreshNeighborMasks()
+    mutable std::vector<std::uint8_t> m_neighborMasks;
+    mutable bool m_neighborMasksDirty = true;
+    std::optional<sf::Vector2i> m_start;
+    std::optional<sf::Vector2i> m_end;
+    ChangeLog m_changes;
+    std::uint64_t m_epoch = 0;
+
+    // Indeks komponent: union-find po vozliščih. Po gradnji je vozlišče celice
+    // njen cellIndex() in vsako kaže naravnost na koren. Ponovno odprta celica
+    // dobi novo vozlišče (m_componentAlias), ker je staro lahko še vedno del
+    // komponente, od katere jo je zid ločil.
+    mutable std::vector<int> m_componentParent;
+    mutable std::vector<std::uint8_t> m_componentRank;
+    mutable std::unordered_map<int, int> m_componentAlias; // celica -> vozlišče
+    mutable bool m_componentsDirty = true;
+
+    Word* wallRowMut(int gy) {
+        return m_walls.data() + static_cast<std::size_t>(gy + 1) * m_stride;
+    }
+
+    void writeWall(int gx, int gy, bool value) {
+        const int bit = gx + 1;
+        const Word mask = Word{1} << (bit % WordBits);
+        Word& w = wallRowMut(gy)[bit / WordBits];
+        const bool was = (w & mask) != 0;
+        w = value ? (w | mask) : (w & ~mask);
+
+        if (was != value) {
+            m_changes.add(cellIndex(gx, gy));
+            updateNeighborMasks(gx, gy, value);
+            ++m_epoch;
+        }
+        if (was == value || m_componentsDirty)
+            return;
+        if (!value)
+            componentCellOpened(gx, gy);
+        else if (mayDisconnect(gx, gy))
+            m_componentsDirty = true;
+    }
+
+    int componentNode(int cell) const {
+        if (m_componentAlias.empty())
+            return cell;
+        auto it = m_componentAlias.find(cell);
+        return it == m_componentAlias.end() ? cell : it->second;
+    }
+
+    // brez krajšanja poti, da je branje varno iz več niti; globino omejuje rank
+    int componentRoot(int node) const {
+        while (m_componentParent[node] != node)
+            node = m_componentParent[node];
+        return node;
+    }
+
+    void componentUnite(int a, int b) const {
+        // halving pri iskanju korenov (samo ob pisanju)
+        auto find = [&](int x) {
+            while (m_componentParent[x] != x) {
+                m_componentParent[x] = m_componentParent[m_componentParent[x]];
+                x = m_componentParent[x];
+            }
+            return x;
+        };
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return;
+        if (m_componentRank[a] < m_componentRank[b])
+            std::swap(a, b);
+        m_componentParent[b] = a;
+        if (m_componentRank[a] == m_componentRank[b])
+            ++m_componentRank[a];
+    }
+
+    // odprta celica združi komponente svojih prostih sosedov
+    void componentCellOpened(int gx, int gy) {
+        const int node = static_cast<int>(m_componentParent.size());
+        m_componentParent.push_back(node);
+        m_componentRank.push_back(0);
+        m_componentAlias[cellIndex(gx, gy)] = node;
+
+        const sf::Vector2i dirs[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (const sf::Vector2i& d : dirs)
+            if (!isWall(gx + d.x, gy + d.y))
+                componentUnite(node, componentNode(cellIndex(gx + d.x, gy + d.y)));
+
+        // preveč novih vozlišč: raje enkrat zgradimo kompakten indeks
+        if (m_componentAlias.size() > static_cast<std::size_t>(cellCount() / 8 + 64))
+            m_componentsDirty = true;
+    }
+
+    // Nov zid na (gx, gy) lahko razdeli komponento le, če prosti 4-sosedje
+    // celice niso povezani po obroču osmih celic okoli nje (zaporedne celice
+    // obroča so 4-sosedje). Tako risanje zidu po odprtem prostoru indeksa ne
+    // zavrže.
+    bool mayDisconnect(int gx, int gy) const {
+        // obroč v smeri urinega kazalca: N, NE, E, SE, S, SW, W, NW
+        const int dx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+        const int dy[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+        bool open[8];
+        int first = -1;
+        for (int i = 0; i < 8; ++i) {
+            open[i] = !isWall(gx + dx[i], gy + dy[i]);
+            if (!open[i] && first == -1)
+                first = i;
+        }
+        if (first == -1)
+            return false;
+
+        // nizi prostih celic obroča, ki vsebujejo vsaj enega 4-soseda (sodi indeksi)
+        int runs = 0;
+        bool inRun = false;
+        bool hasNeighbor = false;
+        for (int k = 1; k <= 8; ++k) {
+            const int i = (first + k) % 8;
+            if (open[i]) {
+                if (!inRun)
+                    hasNeighbor = false;
+                inRun = true;
+                hasNeighbor = hasNeighbor || i % 2 == 0;
+            } else {
+                if (inRun && hasNeighbor)
+                    ++runs;
+                inRun = false;
+            }
+        }
+        return runs > 1;
+    }
+
+    // označevanje po vrsticah: vsaka prosta celica se združi z levo in zgornjo
+    void rebuildComponents() const {
+        const int n = cellCount();
+        m_componentParent.resize(n);
+        std::iota(m_componentParent.begin(), m_componentParent.end(), 0);
+        m_componentRank.assign(n, 0);
+        m_componentAlias.clear();
+
+        const int w = paddedCols();
+        for (int gy = 0; gy < m_rows; ++gy) {
+            for (int gx = 0; gx < m_cols; ++gx) {
+                if (isWall(gx, gy))
+                    continue;
+                const int c = cellIndex(gx, gy);
+                if (!isWall(gx - 1, gy)) componentUnite(c, c - 1);
+                if (!isWall(gx, gy - 1)) componentUnite(c, c - w);
+            }
+        }
+
+        // sploščimo, da je vsaka poizvedba en skok do korena
+        for (int c = 0; c < n; ++c)
+            m_componentParent[c] = componentRoot(c);
+        m_componentsDirty = false;
+    }
+
+    // Generatorji labirinta delajo v koordinatah labirinta: celica (cx, cy)
+    // je celica mreže (2cx + 1, 2cy + 1), prehod v smeri (dx, dy) je celica
+    // med njo in sosedom. Odprta celica labirinta je hkrati "obiskana".
+    // Generator zgradi popoln labirint na pravokotniku MazeArea (celice
+    // area.x0 + cx, area.y0 + cy) in ne piše izven njega.
+    struct MazeArea {
+        int x0 = 0;
+        int y0 = 0;
+        int cols = 0;
+        int rows = 0;
+    };
+
+    void carveMaze(std::mt19937& rng, MazeAlgorithm algorithm, const MazeArea& area) {
+        switch (algorithm) {
+            case MazeAlgorithm::Backtracker: carveBacktracker(rng, area); break;
+            case MazeAlgorithm::Eller:       carveEller(rng, area);       break;
+            case MazeAlgorithm::Kruskal:     carveKruskal(rng, area);     break;
+            case MazeAlgorithm::Wilson:      carveWilson(rng, area);      break;
+        }
+    }
+
+    void carve(int gx, int gy) {
+        const int bit = gx + 1;
+        wallRowMut(gy)[bit / WordBits] &= ~(Word{1} << (bit % WordBits));
+    }
+    void carveMazeCell(const MazeArea& area, int cx, int cy) {
+        carve(2 * (area.x0 + cx) + 1, 2 * (area.y0 + cy) + 1);
+    }
+    void carveMazePassage(const MazeArea& area, int cx, int cy, int dx, int dy) {
+        carve(2 * (area.x0 + cx) + 1 + dx, 2 * (area.y0 + cy) + 1 + dy);
+    }
+    bool mazeCellOpen(const MazeArea& area, int cx, int cy) const {
+        return !isWall(2 * (area.x0 + cx) + 1, 2 * (area.y0 + cy) + 1);
+    }
+
+    // seed za podopravilo index (splitmix64), da so tokovi ploščic neodvisni
+    static std::uint32_t mixSeed(std::uint32_t seed, int index) {
+        std::uint64_t z = (std::uint64_t{seed} << 32 | static_cast<std::uint32_t>(index)) +
+                          0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<std::uint32_t>(z ^ (z >> 31));
+    }
+
+    // enakomerno v [0, n) brez distribucij standardne knjižnice, ki se med
+    // implementacijami razlikujejo
+    static int randomBelow(std::mt19937& rng, int n) {
+        return static_cast<int>((std::uint64_t{rng()} * static_cast<std::uint32_t>(n)) >> 32);
+    }
+
+    // DFS (recursive backtracker, iterativno)
+    void carveBacktracker(std::mt19937& rng, const MazeArea& area) {
+        const int mazeCols = area.cols;
+        const int mazeRows = area.rows;
         using Cell = sf::Vector2i; // (cx, cy) v maze koordinatah
         std::vector<Cell> stack;
-        std::vector<std::vector<bool>> visited(
-            mazeRows, std::vector<bool>(mazeCols, false)
-        );
-
-        auto carveCell = [&](int cx, int cy) {
-            visited[cy][cx] = true;
-            int wx = 2 * cx + 1;
-            int wy = 2 * cy + 1;
-            m_walls[wy][wx] = false;
+        const int dirs[4][2] = {
+            { 1,  0},
+            {-1,  0},
+            { 0,  1},
+            { 0, -1}
         };
 
         // začnemo v (0,0) v maze koordinatah
-        carveCell(0, 0);
+        carveMazeCell(area, 0, 0);
         stack.push_back(Cell{0, 0});
 
-        std::mt19937 rng{std::random_device{}()};
-
         while (!stack.empty()) {
             Cell cur = stack.back();
 
-            std::vector<Cell> neighbors;
-            const int dirs[4][2] = {
-                { 1,  0},
-                {-1,  0},
-                { 0,  1},
-                { 0, -1}
-            };
-
             // pogledamo še neobiskane sosede v maze koordinatah
+            Cell neighbors[4];
+            int count = 0;
             for (auto& d : dirs) {
                 int nx = cur.x + d[0];
                 int ny = cur.y + d[1];
                 if (nx < 0 || nx >= mazeCols || ny < 0 || ny >= mazeRows)
                     continue;
-                if (visited[ny][nx])
+                if (mazeCellOpen(area, nx, ny))
                     continue;
-                neighbors.push_back(Cell{nx, ny});
+                neighbors[count++] = Cell{nx, ny};
             }
 
-            if (neighbors.empty()) {
+            if (count == 0) {
                 stack.pop_back();
                 continue;
             }
 
-            std::uniform_int_distribution<int> dist(0, (int)neighbors.size() - 1);
+            std::uniform_int_distribution<int> dist(0, count - 1);
             Cell next = neighbors[dist(rng)];
 
-            // trenutna celica v grid koordinatah
-            int wx1 = 2 * cur.x + 1;
-            int wy1 = 2 * cur.y + 1;
-            // naslednja celica v grid koordinatah
-            int wx2 = 2 * next.x + 1;
-            int wy2 = 2 * next.y + 1;
-            // stena med njima (sredina)
-            int wxm = (wx1 + wx2) / 2;
-            int wym = (wy1 + wy2) / 2;
-
-            m_walls[wym][wxm] = false;
-            carveCell(next.x, next.y);
+            carveMazePassage(area, cur.x, cur.y, next.x - cur.x, next.y - cur.y);
+            carveMazeCell(area, next.x, next.y);
             stack.push_back(next);
         }
+    }
 
-        // start in end nastavimo v dva kota labirinta
-        int sx = 1;
-        int sy = 1;
-        int ex = 2 * (mazeCols - 1) + 1;
-        int ey = 2 * (mazeRows - 1) + 1;
+    // Eller: vrstico za vrstico, pomnilnik O(mazeCols). set[x] je oznaka
+    // množice celice x v trenutni vrstici, parent je union-find nad oznakami.
+    // Sosednji množici se naključno združita (v zadnji vrstici vedno), vsaka
+    // množica pa ima vsaj en prehod v naslednjo vrstico.
+    void carveEller(std::mt19937& rng, const MazeArea& area) {
+        const int mazeCols = area.cols;
+        const int mazeRows = area.rows;
+        const int w = mazeCols;
+        std::vector<int> set(w);
+        std::vector<int> parent(w);
+        std::vector<int> remaining(w);         // celice množice, ki jih še nismo obdelali
+        std::vector<std::uint8_t> hasDown(w);  // množica že ima prehod navzdol
+        std::vector<std::uint8_t> used(w);     // oznaka je v naslednji vrstici zasedena
+        std::iota(set.begin(), set.end(), 0);
+        std::iota(parent.begin(), parent.end(), 0);
+
+        auto find = [&](int s) {
+            while (parent[s] != s) {
+                parent[s] = parent[parent[s]];
+                s = parent[s];
+            }
+            return s;
+        };
 
-        if (inBounds(sx, sy)) setStart(sx, sy);
-        if (inBounds(ex, ey)) setEnd(ex, ey);
+        for (int cy = 0; cy < mazeRows; ++cy) {
+            const bool lastRow = cy == mazeRows - 1;
+            for (int cx = 0; cx < w; ++cx)
+                carveMazeCell(area, cx, cy);
+
+            for (int cx = 0; cx + 1 < w; ++cx) {
+                const int a = find(set[cx]);
+                const int b = find(set[cx + 1]);
+                if (a != b && (lastRow || (rng() & 1u))) {
+                    parent[b] = a;
+                    carveMazePassage(area, cx, cy, 1, 0);
+                }
+            }
+            if (lastRow)
+                break;
+
+            std::fill(remaining.begin(), remaining.end(), 0);
+            std::fill(hasDown.begin(), hasDown.end(), std::uint8_t{0});
+            std::fill(used.begin(), used.end(), std::uint8_t{0});
+            for (int cx = 0; cx < w; ++cx) {
+                set[cx] = find(set[cx]);
+                ++remaining[set[cx]];
+            }
+
+            for (int cx = 0; cx < w; ++cx) {
+                const int s = set[cx];
+                const bool mustGoDown = --remaining[s] == 0 && !hasDown[s];
+                if (mustGoDown || (rng() & 1u)) {
+                    hasDown[s] = 1;
+                    used[s] = 1;
+                    carveMazePassage(area, cx, cy, 0, 1);
+                } else {
+                    set[cx] = -1;
+                }
+            }
+
+            // celice brez prehoda od zgoraj začnejo novo množico
+            int fresh = 0;
+            for (int cx = 0; cx < w; ++cx) {
+                if (set[cx] != -1)
+                    continue;
+                while (used[fresh])
+                    ++fresh;
+                set[cx] = fresh;
+                used[fresh] = 1;
+            }
+            std::iota(parent.begin(), parent.end(), 0);
+        }
     }
 
-private:
-    int m_cols;
-    int m_rows;
-    int m_cellSize;
+    // Kruskal: stene med sosednjimi celicami v naključnem vrstnem redu;
+    // steno odstranimo, če celici še nista povezani (union-find)
+    void carveKruskal(std::mt19937& rng, const MazeArea& area) {
+        const int mazeCols = area.cols;
+        const int mazeRows = area.rows;
+        const int n = mazeCols * mazeRows;
+
+        // stena = 2 * celica + (0 desno, 1 spodaj)
+        std::vector<std::uint32_t> edges;
+        edges.reserve(2 * static_cast<std::size_t>(n));
+        for (int cy = 0; cy < mazeRows; ++cy) {
+            for (int cx = 0; cx < mazeCols; ++cx) {
+                carveMazeCell(area, cx, cy);
+                const auto c = static_cast<std::uint32_t>(cy * mazeCols + cx);
+                if (cx + 1 < mazeCols) edges.push_back(2 * c);
+                if (cy + 1 < mazeRows) edges.push_back(2 * c + 1);
+            }
+        }
+        for (std::size_t i = edges.size(); i > 1; --i)
+            std::swap(edges[i - 1], edges[randomBelow(rng, static_cast<int>(i))]);
+
+        std::vector<int> parent(n);
+        std::vector<std::uint8_t> rank(n, 0);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&](int x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]];
+                x = parent[x];
+            }
+            return x;
+        };
 
-    std::vector<std::vector<bool>> m_walls;
-    std::optional<sf::Vector2i> m_start;
-    std::optional<sf::Vector2i> m_end;
+        int joins = 0;
+        for (std::uint32_t e : edges) {
+            const int c = static_cast<int>(e >> 1);
+            const bool down = e & 1u;
+            int a = find(c);
+            int b = find(c + (down ? mazeCols : 1));
+            if (a == b)
+                continue;
+            if (rank[a] < rank[b])
+                std::swap(a, b);
+            parent[b] = a;
+            if (rank[a] == rank[b])
+                ++rank[a];
+
+            carveMazePassage(area, c % mazeCols, c / mazeCols, down ? 0 : 1, down ? 1 : 0);
+            if (++joins == n - 1)
+                break;
+        }
+    }
+
+    // Wilson: enakomerno naključno vpeto drevo. Iz vsake celice izven
+    // drevesa naključno hodimo, dokler ne zadenemo drevesa; exitDir hrani
+    // zadnji izhod iz celice, zato ponoven obisk izbriše zanko. Pot brez
+    // zank nato vpnemo v drevo.
+    void carveWilson(std::mt19937& rng, const MazeArea& area) {
+        const int mazeCols = area.cols;
+        const int mazeRows = area.rows;
+        const int dx[4] = {1, -1, 0,  0};
+        const int dy[4] = {0,  0, 1, -1};
+        std::vector<std::uint8_t> exitDir(static_cast<std::size_t>(mazeCols) * mazeRows);
+        auto at = [&](int cx, int cy) -> std::uint8_t& {
+            return exitDir[static_cast<std::size_t>(cy) * mazeCols + cx];
+        };
+
+        carveMazeCell(area, randomBelow(rng, mazeCols), randomBelow(rng, mazeRows));
+
+        for (int y = 0; y < mazeRows; ++y) {
+            for (int x = 0; x < mazeCols; ++x) {
+                int cx = x;
+                int cy = y;
+                while (!mazeCellOpen(area, cx, cy)) {
+                    int d;
+                    do {
+                        d = static_cast<int>(rng() & 3u);
+                    } while (cx + dx[d] < 0 || cx + dx[d] >= mazeCols ||
+                             cy + dy[d] < 0 || cy + dy[d] >= mazeRows);
+                    at(cx, cy) = static_cast<std::uint8_t>(d);
+                    cx += dx[d];
+                    cy += dy[d];
+                }
+
+                cx = x;
+                cy = y;
+                while (!mazeCellOpen(area, cx, cy)) {
+                    const int d = at(cx, cy);
+                    carveMazeCell(area, cx, cy);
+                    carveMazePassage(area, cx, cy, dx[d], dy[d]);
+                    cx += dx[d];
+                    cy += dy[d];
+                }
+            }
+        }
+    }
+
+    // notranjost nastavi na value, rob in poravnalni biti ostanejo zid
+    void fillWalls(bool value) {
+        m_componentsDirty = true;
+        m_neighborMasksDirty = true;
+        m_changes.addAll();
+        ++m_epoch;
+        std::fill(m_walls.begin(), m_walls.end(), ~Word{0});
+        if (value)
+            return;
+
+        // vzorec notranje vrstice: biti 1..m_cols prosti, ostalo zid
+        std::vector<Word> pattern(m_stride, ~Word{0});
+        for (int bit = 1; bit <= m_cols; ++bit)
+            pattern[bit / WordBits] &= ~(Word{1} << (bit % WordBits));
+
+        for (int gy = 0; gy < m_rows; ++gy)
+            std::copy(pattern.begin(), pattern.end(), wallRowMut(gy));
+    }
+
+    // celica (gx, gy) je postala zid ali prosta: iz soseda v smeri d je v smeri d ^ 1
+    void updateNeighborMasks(int gx, int gy, bool wall) {
+        if (m_neighborMasksDirty)
+            return; // celotna gradnja ob naslednji poizvedbi
+        const int cell = cellIndex(gx, gy);
+        const int w = paddedCols();
+        const int offsets[8] = {1, -1, w, -w, w + 1, -w - 1, -w + 1, w - 1};
+        for (int d = 0; d < 8; ++d) {
+            std::uint8_t& mask = m_neighborMasks[cell + offsets[d]];
+            const auto bit = static_cast<std::uint8_t>(1u << (d ^ 1));
+            mask = static_cast<std::uint8_t>(wall ? mask & ~bit : mask | bit);
+        }
+    }
+
+    // bit (8i + j) zamenja z bitom (8j + i) (Hacker's Delight, 7-3)
+    static Word transposeBits8x8(Word x) {
+        Word t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+        x ^= t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+        x ^= t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+        x ^= t ^ (t << 28);
+        return x;
+    }
+
+    // bajt j besede i zamenja z bajtom i besede j (bloki 4, 2, 1)
+    static void transposeBytes8x8(Word (&w)[8]) {
+        for (int i = 0; i < 4; ++i) {
+            const Word t = ((w[i] >> 32) ^ w[i + 4]) & 0x00000000FFFFFFFFULL;
+            w[i] ^= t << 32;
+            w[i + 4] ^= t;
+        }
+        for (int i : {0, 1, 4, 5}) {
+            const Word t = ((w[i] >> 16) ^ w[i + 2]) & 0x0000FFFF0000FFFFULL;
+            w[i] ^= t << 16;
+            w[i + 2] ^= t;
+        }
+        for (int i : {0, 2, 4, 6}) {
+            const Word t = ((w[i] >> 8) ^ w[i + 1]) & 0x00FF00FF00FF00FFULL;
+            w[i] ^= t << 8;
+            w[i + 1] ^= t;
+        }
+    }
+
+    // Maske vrstic [rowBegin, rowEnd) iz bitseta. Za vsako besedo vrstice
+    // pripravimo osem besed prostih sosedov (vrstica nad, ista, pod, zamaknjene
+    // za -1 / 0 / +1 bit) in jih transponiramo: najprej kot matriko 8x8 bajtov
+    // (beseda j ima v bajtu d bajt j smeri d), nato vsako besedo kot bitno
+    // matriko 8x8, da je bajt c besede j maska celice 8j + c. Tako je 64 mask
+    // nekaj deset operacij nad besedami namesto 512 posameznih bitov.
+    void rebuildNeighborMasks(int rowBegin, int rowEnd) const {
+        const int w = paddedCols();
+        // bit i = celica (64k + i + 1) oz. (64k + i - 1); izven vrstice je zid
+        auto east = [&](const Word* r, int k) {
+            return (r[k] >> 1) | (k + 1 < m_stride ? r[k + 1] << (WordBits - 1) : Word{1} << (WordBits - 1));
+        };
+        auto west = [&](const Word* r, int k) {
+            return (r[k] << 1) | (k > 0 ? r[k - 1] >> (WordBits - 1) : Word{1});
+        };
+
+        for (int gy = rowBegin; gy < rowEnd; ++gy) {
+            const Word* up   = wallRow(gy - 1);
+            const Word* row  = wallRow(gy);
+            const Word* down = wallRow(gy + 1);
+            std::uint8_t* masks = m_neighborMasks.data() + static_cast<std::size_t>(gy + 1) * w;
+
+            for (int k = 0; k < m_stride; ++k) {
+                Word open[8] = {
+                    ~east(row, k), ~west(row, k), ~down[k], ~up[k],
+                    ~east(down, k), ~west(up, k), ~east(up, k), ~west(down, k)
+                };
+                transposeBytes8x8(open);
+                for (Word& x : open)
+                    x = transposeBits8x8(x);
+
+                std::uint8_t bytes[WordBits];
+                if constexpr (std::endian::native == std::endian::little) {
+                    std::memcpy(bytes, open, sizeof(bytes));
+                } else {
+                    for (int i = 0; i < WordBits; ++i)
+                        bytes[i] = static_cast<std::uint8_t>(open[i / 8] >> (8 * (i % 8)));
+                }
+                // samo notranje celice (bit 1 .. m_cols)
+                const int first = std::max(k * WordBits, 1);
+                const int last  = std::min((k + 1) * WordBits, m_cols + 1);
+                if (first < last)
+                    std::copy(bytes + (first - k * WordBits), bytes + (last - k * WordBits), masks + first);
+            }
+        }
+    }
 };
@@ -0,0 +1,286 @@
+#include "GridFile.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PATHFINDING_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+bool fail(std::string* error, const std::string& message) {
+    if (error)
+        *error = message;
+    return false;
+}
+
+// Datoteka samo za branje: z mmap, kjer je na voljo, sicer prebrana v pomnilnik
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifdef PATHFINDING_HAVE_MMAP
+        if (m_mapped)
+            munmap(m_mapped, m_size);
+#endif
+    }
+
+    bool open(const std::string& path, std::string* error) {
+#ifdef PATHFINDING_HAVE_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return fail(error, "cannot open " + path);
+        struct stat st {};
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return fail(error, "cannot stat " + path);
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+        if (m_size > 0) {
+            void* p = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                return fail(error, "cannot map " + path);
+            }
+            madvise(p, m_size, MADV_SEQUENTIAL);
+            m_mapped = p;
+            m_data = static_cast<const char*>(p);
+        }
+        ::close(fd);
+        return true;
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            return fail(error, "cannot open " + path);
+        m_buffer.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        if (!in.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size())))
+            return fail(error, "cannot read " + path);
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return true;
+#endif
+    }
+
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    std::string_view view() const { return {m_data, m_size}; }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef PATHFINDING_HAVE_MMAP
+    void* m_mapped = nullptr;
+#else
+    std::vector<char> m_buffer;
+#endif
+};
+
+// cellCount() mora biti int
+bool sizeFits(std::int64_t cols, std::int64_t rows) {
+    return cols > 0 && rows > 0 &&
+           (cols + 2) * (rows + 2) <= std::numeric_limits<int>::max();
+}
+
+int wordsPerRowFor(int cols) {
+    return (cols + 2 + Grid::WordBits - 1) / Grid::WordBits;
+}
+
+} // namespace
+
+bool saveGridFile(const Grid& grid, const std::string& path, std::string* error) {
+    static_assert(std::endian::native == std::endian::little, "grid files are little-endian");
+
+    const std::size_t wallWords = static_cast<std::size_t>(grid.getRows() + 2) * grid.wordsPerRow();
+    const std::size_t cells = static_cast<std::size_t>(grid.cellCount());
+    const std::uint8_t* costs = grid.costData();
+    const bool hasCosts = std::any_of(costs, costs + cells,
+                                      [](std::uint8_t c) { return c != Grid::MinCost; });
+
+    GridFileHeader header{};
+    std::memcpy(header.magic, GridFileMagic, sizeof(header.magic));
+    header.version = GridFileVersion;
+    header.cols = grid.getCols();
+    header.rows = grid.getRows();
+    header.wordsPerRow = grid.wordsPerRow();
+    const sf::Vector2i none{-1, -1};
+    const sf::Vector2i start = grid.getStart().value_or(none);
+    const sf::Vector2i end = grid.getEnd().value_or(none);
+    header.startX = start.x;
+    header.startY = start.y;
+    header.endX = end.x;
+    header.endY = end.y;
+    header.wallsOffset = sizeof(GridFileHeader);
+    header.costsOffset = hasCosts ? header.wallsOffset + wallWords * sizeof(Grid::Word) : 0;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return fail(error, "cannot create " + path);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(grid.wallRow(-1)),
+              static_cast<std::streamsize>(wallWords * sizeof(Grid::Word)));
+    if (hasCosts)
+        out.write(reinterpret_cast<const char*>(costs), static_cast<std::streamsize>(cells));
+    out.flush();
+    if (!out)
+        return fail(error, "cannot write " + path);
+    return true;
+}
+
+std::optional<Grid> loadGridFile(const std::string& path, int cellSize, std::string* error) {
+    MappedFile file;
+    if (!file.open(path, error))
+        return std::nullopt;
+
+    GridFileHeader header;
+    if (file.size() < sizeof(header)) {
+        fail(error, path + ": file too short for a grid header");
+        return std::nullopt;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, GridFileMagic, sizeof(header.magic)) != 0) {
+        fail(error, path + ": not a grid file");
+        return std::nullopt;
+    }
+    if (header.version != GridFileVersion) {
+        fail(error, path + ": unsupported grid file version " + std::to_string(header.version));
+        return std::nullopt;
+    }
+    if (!sizeFits(header.cols, header.rows) || header.wordsPerRow != wordsPerRowFor(header.cols)) {
+        fail(error, path + ": invalid grid size");
+        return std::nullopt;
+    }
+
+    const std::uint64_t wallBytes =
+        static_cast<std::uint64_t>(header.rows + 2) * header.wordsPerRow * sizeof(Grid::Word);
+    const std::uint64_t costBytes = static_cast<std::uint64_t>(header.cols + 2) * (header.rows + 2);
+    auto fits = [&](std::uint64_t offset, std::uint64_t bytes) {
+        return offset >= sizeof(header) && offset % sizeof(Grid::Word) == 0 &&
+               offset <= file.size() && bytes <= file.size() - offset;
+    };
+    if (!fits(header.wallsOffset, wallBytes) ||
+        (header.costsOffset != 0 && !fits(header.costsOffset, costBytes))) {
+        fail(error, path + ": truncated grid file");
+        return std::nullopt;
+    }
+
+    // preslikava je poravnana na stran, odmiki na besedo, zato beremo neposredno
+    Grid grid(header.cols, header.rows, cellSize,
+              reinterpret_cast<const Grid::Word*>(file.data() + header.wallsOffset),
+              header.costsOffset != 0
+                  ? reinterpret_cast<const std::uint8_t*>(file.data() + header.costsOffset)
+                  : nullptr);
+
+    if (grid.inBounds(header.startX, header.startY))
+        grid.setStart(header.startX, header.startY);
+    if (grid.inBounds(header.endX, header.endY))
+        grid.setEnd(header.endX, header.endY);
+    grid.changes().addAll();
+    return grid;
+}
+
+std::optional<Grid> parseMovingAIMap(std::string_view text, int cellSize, std::string* error) {
+    std::size_t pos = 0;
+    auto nextLine = [&]() {
+        const std::size_t end = std::min(text.find('\n', pos), text.size());
+        std::string_view line = text.substr(pos, end - pos);
+        pos = end + 1;
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        return line;
+    };
+
+    // glava: "type ...", "height H", "width W", "map" (vrstni red height/width poljuben)
+    std::int64_t width = -1;
+    std::int64_t height = -1;
+    bool sawMap = false;
+    while (pos < text.size() && !sawMap) {
+        const std::string_view line = nextLine();
+        auto value = [&](std::string_view key) -> std::int64_t {
+            return std::atoll(std::string(line.substr(key.size())).c_str());
+        };
+        if (line.starts_with("height "))
+            height = value("height ");
+        else if (line.starts_with("width "))
+            width = value("width ");
+        else if (line == "map")
+            sawMap = true;
+        else if (!line.starts_with("type ") && !line.empty()) {
+            fail(error, "unexpected MovingAI header line: " + std::string(line));
+            return std::nullopt;
+        }
+    }
+    if (!sawMap || !sizeFits(width, height)) {
+        fail(error, "missing or invalid MovingAI header");
+        return std::nullopt;
+    }
+
+    const int cols = static_cast<int>(width);
+    const int rows = static_cast<int>(height);
+    const int stride = wordsPerRowFor(cols);
+
+    // vse zid, nato odpremo proste celice; rob popravi assignCells
+    std::vector<Grid::Word> walls(static_cast<std::size_t>(rows + 2) * stride, ~Grid::Word{0});
+    for (int gy = 0; gy < rows; ++gy) {
+        if (pos >= text.size()) {
+            fail(error, "MovingAI map has " + std::to_string(gy) + " rows, expected " +
+                        std::to_string(rows));
+            return std::nullopt;
+        }
+        const std::string_view line = nextLine();
+        if (static_cast<int>(line.size()) < cols) {
+            fail(error, "MovingAI map row " + std::to_string(gy) + " is too short");
+            return std::nullopt;
+        }
+        Grid::Word* row = walls.data() + static_cast<std::size_t>(gy + 1) * stride;
+        for (int gx = 0; gx < cols; ++gx) {
+            const char c = line[gx];
+            if (c == '.' || c == 'G' || c == 'S') {
+                const int bit = gx + 1;
+                row[bit / Grid::WordBits] &= ~(Grid::Word{1} << (bit % Grid::WordBits));
+            }
+        }
+    }
+
+    return Grid(cols, rows, cellSize, walls.data(), nullptr);
+}
+
+std::optional<Grid> loadMovingAIMap(const std::string& path, int cellSize, std::string* error) {
+    MappedFile file;
+    if (!file.open(path, error))
+        return std::nullopt;
+    std::string parseError;
+    auto grid = parseMovingAIMap(file.view(), cellSize, &parseError);
+    if (!grid)
+        fail(error, path + ": " + parseError);
+    return grid;
+}
+
+std::optional<Grid> loadGrid(const std::string& path, int cellSize, std::string* error) {
+    char magic[sizeof(GridFileMagic)] = {};
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            fail(error, "cannot open " + path);
+            return std::nullopt;
+        }
+        in.read(magic, sizeof(magic));
+    }
+    if (std::memcmp(magic, GridFileMagic, sizeof(magic)) == 0)
+        return loadGridFile(path, cellSize, error);
+    return loadMovingAIMap(path, cellSize, error);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Grid.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Shranjevanje in nalaganje mreže.
+//
+// Binarna oblika (.pfg, little-endian) je ista kot postavitev v pomnilniku
+// Grid, zato nalaganje ne gre čez celice: datoteka se preslika z mmap, zidovi
+// in cene pa se v mrežo prepišejo vsak z enim kopiranjem (Grid::assignCells).
+//
+//   GridFileHeader (64 B)
+//   zidovi: (rows + 2) * wordsPerRow 64-bitnih besed, vrstice z robom kot
+//           Grid::wallRow(-1 .. rows), bit (gx + 1) je celica gx
+//   cene:   (cols + 2) * (rows + 2) bajtov po Grid::cellIndex(), samo če je
+//           costsOffset != 0 (sicer so vse cene MinCost)
+//
+// MovingAI .map (https://movingai.com/benchmarks/formats.html) je besedilna
+// oblika z glavo "type / height / width / map" in vrsticami znakov: '.', 'G'
+// in 'S' so prosti, ostali ('@', 'O', 'T', 'W') so zid. Start in cilj nista
+// del .map, ju pa podajo scenariji (.scen).
+struct GridFileHeader {
+    char magic[8];             // "PFGRID\0\0"
+    std::uint32_t version;
+    std::uint32_t flags;       // trenutno 0
+    std::int32_t cols;
+    std::int32_t rows;
+    std::int32_t wordsPerRow;
+    std::int32_t startX, startY; // -1, če ni nastavljen
+    std::int32_t endX, endY;
+    std::uint32_t reserved;
+    std::uint64_t wallsOffset;
+    std::uint64_t costsOffset; // 0 = brez cen
+};
+
+static_assert(sizeof(GridFileHeader) == 64);
+
+inline constexpr char GridFileMagic[8] = {'P', 'F', 'G', 'R', 'I', 'D', '\0', '\0'};
+inline constexpr std::uint32_t GridFileVersion = 1;
+
+// Ob napaki funkcije vrnejo nullopt / false in, če error ni nullptr, vanj
+// zapišejo opis napake.
+
+// cene se zapišejo samo, če ima kakšna celica ceno različno od MinCost
+bool saveGridFile(const Grid& grid, const std::string& path, std::string* error = nullptr);
+
+std::optional<Grid> loadGridFile(const std::string& path, int cellSize, std::string* error = nullptr);
+
+std::optional<Grid> loadMovingAIMap(const std::string& path, int cellSize, std::string* error = nullptr);
+
+// MovingAI .map iz besedila v pomnilniku
+std::optional<Grid> parseMovingAIMap(std::string_view text, int cellSize, std::string* error = nullptr);
+
+// binarna oblika ali MovingAI .map, glede na začetek datoteke
+std::optional<Grid> loadGrid(const std::string& path, int cellSize, std::string* error = nullptr);
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ChangeLog.hpp"
+#include "Grid.hpp"
+
+// Izris mreže po kosih (chunk), ki so v trenutnem sf::View vidni. Kos je
+// ChunkBlocks x ChunkBlocks blokov v enem sf::VertexArray (dva trikotnika na
+// blok) in se nariše z enim klicem draw(), zato je čas frame-a odvisen od
+// vidnega dela mreže in ne od njene velikosti.
+//
+// Raven podrobnosti (LOD): na ravni 0 je blok ena celica, na ravni L pa
+// 2^L x 2^L celic. Raven se izbere tako, da je blok na zaslonu velik vsaj
+// MinBlockPixels. Barva bloka je najpomembnejša barva (pot, closed, open)
+// med največ 4x4 vzorčnimi celicami, sicer povprečje ozadja (zid, teren);
+// blok s startom ali ciljem je zelen oz. rdeč. Pot se na ravneh nad 0
+// nariše še kot črta, da je vidna tudi, ko je ožja od bloka.
+//
+// Kosi se zgradijo ob prvem prikazu in ostanejo v predpomnilniku (najdlje
+// neuporabljeni se zavržejo). Spremembe iz dnevnikov mreže (Grid::changes())
+// in runnerja (runnerChanges(), podan runnerju s setChangeLog()) prebarvajo
+// samo prizadete bloke kosov v predpomnilniku.
+class GridRenderer {
+public:
+    static constexpr int ChunkBlocks = 64;
+    static constexpr float MinBlockPixels = 2.f;
+
+    explicit GridRenderer(Grid& grid) : m_grid(&grid) {
+        const int extent = std::max(grid.getCols(), grid.getRows());
+        while (m_maxLevel < MaxLevels - 1 && (1 << m_maxLevel) < extent)
+            ++m_maxLevel;
+    }
+
+    // dnevnik, v katerega piše aktivni runner
+    ChangeLog& runnerChanges() { return m_runnerChanges; }
+
+    // runner se je zamenjal ali ustavil: naslednji draw() prebarva vse
+    void invalidate() { m_runnerChanges.addAll(); }
+
+    // Prebere dnevnika sprememb in nariše kose, ki jih pokriva pogled
+    // target.getView(); algo je nullptr, ko ni aktivnega runnerja.
+    template <class Algo>
+    void draw(sf::RenderTarget& target, const Algo* algo) {
+        applyChanges();
+
+        const sf::View& view = target.getView();
+        const float cellSize = static_cast<float>(m_grid->getCellSize());
+        const float viewportPixels = view.getViewport().size.x * static_cast<float>(target.getSize().x);
+        const float cellPixels = view.getSize().x > 0.f
+            ? viewportPixels / view.getSize().x * cellSize : cellSize;
+
+        int level = 0;
+        while (level < m_maxLevel && cellPixels * static_cast<float>(1 << level) < MinBlockPixels)
+            ++level;
+        m_level = level;
+
+        // vidni pravokotnik v celicah (pogled brez rotacije)
+        const sf::Vector2f half = view.getSize() / 2.f;
+        const sf::Vector2f topLeft = view.getCenter() - half;
+        const sf::Vector2f bottomRight = view.getCenter() + half;
+        const int x0 = std::max(0, static_cast<int>(std::floor(topLeft.x / cellSize)));
+        const int y0 = std::max(0, static_cast<int>(std::floor(topLeft.y / cellSize)));
+        const int x1 = std::min(m_grid->getCols() - 1, static_cast<int>(std::floor(bottomRight.x / cellSize)));
+        const int y1 = std::min(m_grid->getRows() - 1, static_cast<int>(std::floor(bottomRight.y / cellSize)));
+
+        ++m_frame;
+        m_chunksDrawn = 0;
+        if (x0 <= x1 && y0 <= y1) {
+            const int span = ChunkBlocks << level;
+            for (int cy = y0 / span; cy <= y1 / span; ++cy) {
+                for (int cx = x0 / span; cx <= x1 / span; ++cx) {
+                    Chunk& chunk = acquire(level, cx, cy);
+                    refresh(chunk, algo);
+                    chunk.lastUsed = m_frame;
+                    target.draw(chunk.vertices);
+                    ++m_chunksDrawn;
+                }
+            }
+        }
+
+        if (algo && level > 0)
+            drawPath(target, algo->getPath());
+
+        evict(std::max(MinCachedChunks, 2 * m_chunksDrawn));
+    }
+
+    // za HUD: raven zadnjega izrisa in število narisanih kosov
+    int level() const { return m_level; }
+    int chunksDrawn() const { return m_chunksDrawn; }
+    int chunksCached() const { return static_cast<int>(m_chunks.size()); }
+
+private:
+    static constexpr int VerticesPerBlock = 6;
+    static constexpr int MaxLevels = 24;
+    static constexpr int MinCachedChunks = 96;
+    static constexpr int SamplesPerAxis = 4;
+
+    struct Chunk {
+        int level = 0;
+        int x0 = 0, y0 = 0;     // prva celica kosa
+        int blocksX = 0, blocksY = 0;
+        sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+        std::vector<int> dirtyBlocks; // lokalni indeksi blokov (by * blocksX + bx)
+        bool allDirty = true;
+        std::uint64_t lastUsed = 0;
+    };
+
+    // barva celice in njena pomembnost pri združevanju v blok (0 = ozadje)
+    struct Shade {
+        sf::Color color;
+        int rank = 0;
+    };
+
+    Grid* m_grid;
+    ChangeLog m_runnerChanges;
+
+    std::unordered_map<std::uint64_t, Chunk> m_chunks;
+    std::array<int, MaxLevels> m_levelChunks{}; // kosi v predpomnilniku po ravneh
+    int m_maxLevel = 0;
+    std::uint64_t m_frame = 0;
+
+    int m_level = 0;
+    int m_chunksDrawn = 0;
+
+    sf::VertexArray m_pathLine{sf::PrimitiveType::LineStrip};
+
+    static std::uint64_t chunkKey(int level, int cx, int cy) {
+        return (static_cast<std::uint64_t>(level) << 56)
+             | (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cy)) << 28)
+             | static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx));
+    }
+
+    // spremembe iz dnevnikov označijo bloke kosov v predpomnilniku
+    void applyChanges() {
+        ChangeLog& gridChanges = m_grid->changes();
+        if (gridChanges.allChanged() || m_runnerChanges.allChanged()) {
+            for (auto& [key, chunk] : m_chunks) {
+                chunk.allDirty = true;
+                chunk.dirtyBlocks.clear();
+            }
+        } else if (!m_chunks.empty()) {
+            for (const ChangeLog* log : {&gridChanges, &m_runnerChanges}) {
+                for (int cell : log->cells()) {
+                    const sf::Vector2i p = m_grid->cellPos(cell);
+                    if (m_grid->inBounds(p.x, p.y))
+                        markDirty(p.x, p.y);
+                }
+            }
+        }
+        gridChanges.clear();
+        m_runnerChanges.clear();
+    }
+
+    void markDirty(int gx, int gy) {
+        for (int level = 0; level <= m_maxLevel; ++level) {
+            if (m_levelChunks[level] == 0)
+                continue;
+            const int span = ChunkBlocks << level;
+            auto it = m_chunks.find(chunkKey(level, gx / span, gy / span));
+            if (it == m_chunks.end())
+                continue;
+            Chunk& chunk = it->second;
+            if (chunk.allDirty)
+                continue;
+            // pri veliko spremembah je ceneje prebarvati cel kos
+            if (chunk.dirtyBlocks.size() >= static_cast<std::size_t>(chunk.blocksX * chunk.blocksY / 4)) {
+                chunk.allDirty = true;
+                chunk.dirtyBlocks.clear();
+                continue;
+            }
+            const int bx = (gx - chunk.x0) >> level;
+            const int by = (gy - chunk.y0) >> level;
+            chunk.dirtyBlocks.push_back(by * chunk.blocksX + bx);
+        }
+    }
+
+    Chunk& acquire(int level, int cx, int cy) {
+        auto [it, inserted] = m_chunks.try_emplace(chunkKey(level, cx, cy));
+        Chunk& chunk = it->second;
+        if (!inserted)
+            return chunk;
+
+        ++m_levelChunks[level];
+        const int block = 1 << level;
+        const int span = ChunkBlocks << level;
+        chunk.level = level;
+        chunk.x0 = cx * span;
+        chunk.y0 = cy * span;
+        chunk.blocksX = (std::min(span, m_grid->getCols() - chunk.x0) + block - 1) >> level;
+        chunk.blocksY = (std::min(span, m_grid->getRows() - chunk.y0) + block - 1) >> level;
+        chunk.vertices.resize(static_cast<std::size_t>(chunk.blocksX) * chunk.blocksY * VerticesPerBlock);
+
+        // na ravni 0 je celica 1 enoto manjša od koraka mreže, da ostane
+        // vidna črta med celicami; večji bloki se stikajo
+        const float cellSize = static_cast<float>(m_grid->getCellSize());
+        for (int by = 0; by < chunk.blocksY; ++by) {
+            for (int bx = 0; bx < chunk.blocksX; ++bx) {
+                const int gx = chunk.x0 + (bx << level);
+                const int gy = chunk.y0 + (by << level);
+                const sf::Vector2f p = m_grid->cellToWorld(gx, gy);
+                const sf::Vector2f size = level == 0
+                    ? sf::Vector2f{cellSize - 1.f, cellSize - 1.f}
+                    : sf::Vector2f{static_cast<float>(std::min(block, m_grid->getCols() - gx)) * cellSize,
+                                   static_cast<float>(std::min(block, m_grid->getRows() - gy)) * cellSize};
+                const sf::Vector2f corners[VerticesPerBlock] = {
+                    p, {p.x + size.x, p.y}, {p.x, p.y + size.y},
+                    {p.x, p.y + size.y}, {p.x + size.x, p.y}, {p.x + size.x, p.y + size.y},
+                };
+                sf::Vertex* v = &chunk.vertices[static_cast<std::size_t>(by * chunk.blocksX + bx) * VerticesPerBlock];
+                for (int i = 0; i < VerticesPerBlock; ++i)
+                    v[i].position = corners[i];
+            }
+        }
+        return chunk;
+    }
+
+    template <class Algo>
+    void refresh(Chunk& chunk, const Algo* algo) {
+        if (chunk.allDirty) {
+            for (int i = 0; i < chunk.blocksX * chunk.blocksY; ++i)
+                setColor(chunk, i, blockColor(chunk, i, algo));
+        } else {
+            for (int i : chunk.dirtyBlocks)
+                setColor(chunk, i, blockColor(chunk, i, algo));
+        }
+        chunk.allDirty = false;
+        chunk.dirtyBlocks.clear();
+    }
+
+    // najdlje neuporabljeni kosi gredo ven, ko jih je več kot limit
+    void evict(int limit) {
+        if (static_cast<int>(m_chunks.size()) <= limit)
+            return;
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> byAge; // (lastUsed, key)
+        byAge.reserve(m_chunks.size());
+        for (const auto& [key, chunk] : m_chunks)
+            byAge.emplace_back(chunk.lastUsed, key);
+        const std::size_t excess = m_chunks.size() - static_cast<std::size_t>(limit);
+        std::nth_element(byAge.begin(), byAge.begin() + static_cast<std::ptrdiff_t>(excess), byAge.end());
+        for (std::size_t i = 0; i < excess; ++i) {
+            auto it = m_chunks.find(byAge[i].second);
+            --m_levelChunks[it->second.level];
+            m_chunks.erase(it);
+        }
+    }
+
+    static void setColor(Chunk& chunk, int block, sf::Color color) {
+        sf::Vertex* v = &chunk.vertices[static_cast<std::size_t>(block) * VerticesPerBlock];
+        for (int i = 0; i < VerticesPerBlock; ++i)
+            v[i].color = color;
+    }
+
+    template <class Algo>
+    sf::Color blockColor(const Chunk& chunk, int block, const Algo* algo) const {
+        const int gx = chunk.x0 + ((block % chunk.blocksX) << chunk.level);
+        const int gy = chunk.y0 + ((block / chunk.blocksX) << chunk.level);
+        if (chunk.level == 0)
+            return cellShade(algo, gx, gy).color;
+
+        const int w = std::min(1 << chunk.level, m_grid->getCols() - gx);
+        const int h = std::min(1 << chunk.level, m_grid->getRows() - gy);
+        auto contains = [&](const std::optional<sf::Vector2i>& p) {
+            return p && p->x >= gx && p->x < gx + w && p->y >= gy && p->y < gy + h;
+        };
+        if (contains(m_grid->getStart())) return sf::Color::Green;
+        if (contains(m_grid->getEnd()))   return sf::Color::Red;
+
+        // vzorci na sredinah enakih delov bloka
+        const int sx = std::min(w, SamplesPerAxis);
+        const int sy = std::min(h, SamplesPerAxis);
+        Shade best;
+        int sum[3] = {0, 0, 0};
+        for (int j = 0; j < sy; ++j) {
+            for (int i = 0; i < sx; ++i) {
+                const Shade s = cellShade(algo, gx + (2 * i + 1) * w / (2 * sx),
+                                          gy + (2 * j + 1) * h / (2 * sy));
+                if (s.rank > best.rank)
+                    best = s;
+                sum[0] += s.color.r;
+                sum[1] += s.color.g;
+                sum[2] += s.color.b;
+            }
+        }
+        if (best.rank > 0)
+            return best.color;
+        const int n = sx * sy;
+        return sf::Color(static_cast<std::uint8_t>(sum[0] / n),
+                         static_cast<std::uint8_t>(sum[1] / n),
+                         static_cast<std::uint8_t>(sum[2] / n));
+    }
+
+    void drawPath(sf::RenderTarget& target, const std::vector<sf::Vector2i>& path) {
+        if (path.size() < 2)
+            return;
+        const float half = static_cast<float>(m_grid->getCellSize()) / 2.f;
+        m_pathLine.resize(path.size());
+        for (std::size_t i = 0; i < path.size(); ++i) {
+            m_pathLine[i].position = m_grid->cellToWorld(path[i].x, path[i].y) + sf::Vector2f{half, half};
+            m_pathLine[i].color = sf::Color(200, 60, 255);
+        }
+        target.draw(m_pathLine);
+    }
+
+    template <class Algo>
+    Shade cellShade(const Algo* algo, int x, int y) const {
+        const Grid& grid = *m_grid;
+
+        if (grid.isStart(x, y)) return {sf::Color::Green, 5};
+        if (grid.isEnd(x, y))   return {sf::Color::Red, 5};
+
+        if (algo) {
+            // fronta od cilja pri dvosmernem iskanju
+            bool backward = false;
+            if constexpr (requires { algo->isBackward(x, y); })
+                backward = algo->isBackward(x, y);
+
+            if (algo->isInPath(x, y))
+                return {sf::Color(128, 0, 128), 4};
+            if (algo->isClosed(x, y))
+                return {backward ? sf::Color(255, 140, 0) : sf::Color::Yellow, 2};
+            if (algo->isOpen(x, y))
+                return {backward ? sf::Color::Cyan : sf::Color::Blue, 3};
+        }
+
+        if (grid.isWall(x, y))
+            return {sf::Color(100, 100, 100)};
+
+        if (grid.getCost(x, y) > Grid::MinCost) {
+            // dražji teren je bolj rjav
+            const float t = std::min(1.f, (grid.getCost(x, y) - 1) / 9.f);
+            return {sf::Color(
+                static_cast<std::uint8_t>(50 + t * 89),
+                static_cast<std::uint8_t>(50 + t * 40),
+                static_cast<std::uint8_t>(50 - t * 20)
+            )};
+        }
+        return {sf::Color(50, 50, 50)};
+    }
+};
@@ -0,0 +1,462 @@
+#include "HPAStarRunner.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+// ---------------------------------------------------------------------------
+// HierarchicalGraph
+
+HierarchicalGraph::HierarchicalGraph(const Grid& grid, int clusterSize, int threads)
+    : m_grid(&grid),
+      // gruča 1x1 bi imela celice na štirih mejah hkrati (Node ima dva para)
+      m_clusterSize(std::max(clusterSize, 2)),
+      m_pool(std::make_unique<ThreadPool>(threads))
+{
+    m_scratch.resize(m_pool->size());
+    rebuild();
+}
+
+HierarchicalGraph::~HierarchicalGraph() = default;
+
+int HierarchicalGraph::nodeCount() const {
+    int n = 0;
+    for (const Cluster& c : m_clusters)
+        n += static_cast<int>(c.nodes.size());
+    return n;
+}
+
+const HierarchicalGraph::Node* HierarchicalGraph::findNode(int cell) const {
+    // vozlišč v gruči je malo (nekaj na mejo), linearno iskanje je najhitrejše
+    for (const Node& node : clusterAt(cell).nodes)
+        if (node.cell == cell)
+            return &node;
+    return nullptr;
+}
+
+void HierarchicalGraph::rebuild() {
+    const int cols = m_grid->getCols();
+    const int rows = m_grid->getRows();
+    m_clustersX = (cols + m_clusterSize - 1) / m_clusterSize;
+    m_clustersY = (rows + m_clusterSize - 1) / m_clusterSize;
+
+    const int count = m_clustersX * m_clustersY;
+    m_clusters.assign(count, Cluster{});
+    m_east.assign(count, {});
+    m_south.assign(count, {});
+
+    std::vector<int> all(count);
+    for (int k = 0; k < count; ++k) {
+        Cluster& c = m_clusters[k];
+        c.x0 = (k % m_clustersX) * m_clusterSize;
+        c.y0 = (k / m_clustersX) * m_clusterSize;
+        c.x1 = std::min(c.x0 + m_clusterSize, cols) - 1;
+        c.y1 = std::min(c.y0 + m_clusterSize, rows) - 1;
+        all[k] = k;
+    }
+
+    for (int k = 0; k < count; ++k) {
+        buildEastBorder(k);
+        buildSouthBorder(k);
+    }
+    rebuildClusters(all);
+}
+
+void HierarchicalGraph::update(std::span<const sf::Vector2i> changed) {
+    std::vector<std::uint8_t> dirty(m_clusters.size(), 0);
+
+    // meja med k in sosedom: če se vhodi spremenijo, se spremenijo vozlišča obeh
+    auto border = [&](int k, int neighbor, bool east) {
+        auto& list = east ? m_east[k] : m_south[k];
+        const auto old = list;
+        east ? buildEastBorder(k) : buildSouthBorder(k);
+        if (list != old) {
+            dirty[k] = 1;
+            dirty[neighbor] = 1;
+        }
+    };
+
+    for (const sf::Vector2i& p : changed) {
+        if (!m_grid->inBounds(p.x, p.y))
+            continue;
+        const int k = clusterOf(p.x, p.y);
+        const Cluster& c = m_clusters[k];
+        dirty[k] = 1;
+
+        if (p.x == c.x1 && k % m_clustersX != m_clustersX - 1) border(k, k + 1, true);
+        if (p.x == c.x0 && k % m_clustersX != 0)               border(k - 1, k, true);
+        if (p.y == c.y1 && k / m_clustersX != m_clustersY - 1) border(k, k + m_clustersX, false);
+        if (p.y == c.y0 && k / m_clustersX != 0)               border(k - m_clustersX, k, false);
+    }
+
+    std::vector<int> clusters;
+    for (int k = 0; k < static_cast<int>(dirty.size()); ++k)
+        if (dirty[k])
+            clusters.push_back(k);
+    rebuildClusters(clusters);
+}
+
+namespace {
+
+// Nizi celic, prostih na obeh straneh meje; at(i) vrne par celic za i-to
+// celico meje ali -1, če je ena od njiju zid. Krajši niz dobi en vhod na
+// sredini, daljši dva na koncih (kot v članku o HPA*).
+template <class At>
+void collectEntrances(int length, At at, std::vector<std::pair<int, int>>& out) {
+    constexpr int LongRun = 6;
+    out.clear();
+    int i = 0;
+    while (i < length) {
+        if (at(i).first == -1) {
+            ++i;
+            continue;
+        }
+        const int begin = i;
+        while (i < length && at(i).first != -1)
+            ++i;
+        const int end = i - 1;
+
+        if (end - begin + 1 < LongRun) {
+            out.push_back(at((begin + end) / 2));
+        } else {
+            out.push_back(at(begin));
+            out.push_back(at(end));
+        }
+    }
+}
+
+} // namespace
+
+void HierarchicalGraph::buildEastBorder(int k) {
+    const Cluster& c = m_clusters[k];
+    if (c.x1 + 1 >= m_grid->getCols()) {
+        m_east[k].clear();
+        return;
+    }
+    collectEntrances(c.y1 - c.y0 + 1, [&](int i) {
+        const int y = c.y0 + i;
+        if (m_grid->isWall(c.x1, y) || m_grid->isWall(c.x1 + 1, y))
+            return std::pair{-1, -1};
+        return std::pair{m_grid->cellIndex(c.x1, y), m_grid->cellIndex(c.x1 + 1, y)};
+    }, m_east[k]);
+}
+
+void HierarchicalGraph::buildSouthBorder(int k) {
+    const Cluster& c = m_clusters[k];
+    if (c.y1 + 1 >= m_grid->getRows()) {
+        m_south[k].clear();
+        return;
+    }
+    collectEntrances(c.x1 - c.x0 + 1, [&](int i) {
+        const int x = c.x0 + i;
+        if (m_grid->isWall(x, c.y1) || m_grid->isWall(x, c.y1 + 1))
+            return std::pair{-1, -1};
+        return std::pair{m_grid->cellIndex(x, c.y1), m_grid->cellIndex(x, c.y1 + 1)};
+    }, m_south[k]);
+}
+
+void HierarchicalGraph::buildCluster(int k, LocalSearch& scratch) {
+    Cluster& c = m_clusters[k];
+    c.nodes.clear();
+
+    auto addNode = [&](int cell, int across) {
+        for (Node& node : c.nodes) {
+            if (node.cell == cell) {
+                node.across[1] = across;
+                return;
+            }
+        }
+        Node node{cell};
+        node.across[0] = across;
+        c.nodes.push_back(node);
+    };
+
+    // vhodi na vseh štirih mejah (zahodna in severna sta zapisani pri sosedu)
+    const int cx = k % m_clustersX;
+    const int cy = k / m_clustersX;
+    for (const auto& [in, out] : m_east[k])  addNode(in, out);
+    for (const auto& [in, out] : m_south[k]) addNode(in, out);
+    if (cx > 0)
+        for (const auto& [out, in] : m_east[k - 1]) addNode(in, out);
+    if (cy > 0)
+        for (const auto& [out, in] : m_south[k - m_clustersX]) addNode(in, out);
+
+    const int n = static_cast<int>(c.nodes.size());
+    c.dist.assign(static_cast<std::size_t>(n) * n, INF);
+
+    const int w = c.x1 - c.x0 + 1;
+    for (int i = 0; i < n; ++i) {
+        localDijkstra(c, c.nodes[i].cell, false, -1, scratch);
+        for (int j = 0; j < n; ++j) {
+            const sf::Vector2i p = m_grid->cellPos(c.nodes[j].cell);
+            c.dist[i * n + j] = scratch.dist[(p.y - c.y0) * w + (p.x - c.x0)];
+        }
+    }
+}
+
+void HierarchicalGraph::rebuildClusters(const std::vector<int>& clusters) {
+    m_clustersRebuilt = static_cast<int>(clusters.size());
+    m_pool->parallelFor(static_cast<int>(clusters.size()), [&](int worker, int i) {
+        buildCluster(clusters[i], m_scratch[worker]);
+    });
+}
+
+void HierarchicalGraph::localDijkstra(const Cluster& c, int source, bool reverse, int target,
+                                      LocalSearch& scratch) const {
+    const int w = c.x1 - c.x0 + 1;
+    const int h = c.y1 - c.y0 + 1;
+    scratch.dist.assign(static_cast<std::size_t>(w) * h, INF);
+    scratch.parent.assign(static_cast<std::size_t>(w) * h, -1);
+    scratch.heap.clear();
+
+    const auto greater = std::greater<std::pair<int, int>>{};
+    const sf::Vector2i s = m_grid->cellPos(source);
+    const int sl = (s.y - c.y0) * w + (s.x - c.x0);
+    scratch.dist[sl] = 0;
+    scratch.heap.push_back({0, sl});
+
+    const int tl = [&] {
+        if (target == -1) return -1;
+        const sf::Vector2i t = m_grid->cellPos(target);
+        return (t.y - c.y0) * w + (t.x - c.x0);
+    }();
+
+    while (!scratch.heap.empty()) {
+        std::pop_heap(scratch.heap.begin(), scratch.heap.end(), greater);
+        const auto [d, u] = scratch.heap.back();
+        scratch.heap.pop_back();
+        if (d != scratch.dist[u])
+            continue;
+        ++scratch.expanded;
+        if (u == tl)
+            break;
+
+        const int ux = c.x0 + u % w;
+        const int uy = c.y0 + u / w;
+        // vstop v celico stane njen teren; v obratni smeri plačamo vstop v u
+        const int costU = m_grid->getCost(ux, uy);
+        const int dx[4] = {1, -1, 0, 0};
+        const int dy[4] = {0, 0, 1, -1};
+        for (int dir = 0; dir < 4; ++dir) {
+            const int vx = ux + dx[dir];
+            const int vy = uy + dy[dir];
+            if (vx < c.x0 || vx > c.x1 || vy < c.y0 || vy > c.y1 || m_grid->isWall(vx, vy))
+                continue;
+            const int v = (vy - c.y0) * w + (vx - c.x0);
+            const int nd = d + (reverse ? costU : m_grid->getCost(vx, vy));
+            if (nd < scratch.dist[v]) {
+                scratch.dist[v] = nd;
+                scratch.parent[v] = u;
+                scratch.heap.push_back({nd, v});
+                std::push_heap(scratch.heap.begin(), scratch.heap.end(), greater);
+            }
+        }
+    }
+}
+
+void HierarchicalGraph::connect(sf::Vector2i cell, bool reverse, sf::Vector2i other,
+                                LocalSearch& scratch, std::vector<std::pair<int, int>>& out) const {
+    out.clear();
+    const Cluster& c = m_clusters[clusterOf(cell.x, cell.y)];
+    localDijkstra(c, m_grid->cellIndex(cell.x, cell.y), reverse, -1, scratch);
+
+    const int w = c.x1 - c.x0 + 1;
+    auto local = [&](sf::Vector2i p) { return scratch.dist[(p.y - c.y0) * w + (p.x - c.x0)]; };
+
+    for (const Node& node : c.nodes) {
+        const int d = local(m_grid->cellPos(node.cell));
+        if (d != INF)
+            out.push_back({node.cell, d});
+    }
+    if (other.x >= c.x0 && other.x <= c.x1 && other.y >= c.y0 && other.y <= c.y1 &&
+        local(other) != INF && !isNode(m_grid->cellIndex(other.x, other.y)))
+        out.push_back({m_grid->cellIndex(other.x, other.y), local(other)});
+}
+
+int HierarchicalGraph::refine(int from, int to, LocalSearch& scratch,
+                              std::vector<sf::Vector2i>& out) const {
+    const Cluster& c = clusterAt(from);
+    localDijkstra(c, from, false, to, scratch);
+
+    const int w = c.x1 - c.x0 + 1;
+    const sf::Vector2i t = m_grid->cellPos(to);
+    const int tl = (t.y - c.y0) * w + (t.x - c.x0);
+    if (scratch.dist[tl] == INF)
+        return INF;
+
+    // pot od cilja nazaj po starših, nato obrnemo
+    const std::size_t first = out.size();
+    for (int u = tl; scratch.parent[u] != -1; u = scratch.parent[u])
+        out.push_back({c.x0 + u % w, c.y0 + u / w});
+    std::reverse(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+    return scratch.dist[tl];
+}
+
+// ---------------------------------------------------------------------------
+// HPAStarRunner
+
+HPAStarRunner::HPAStarRunner(const Grid& grid)
+    : HPAStarRunner(grid, std::make_shared<const HierarchicalGraph>(grid))
+{
+}
+
+HPAStarRunner::HPAStarRunner(const Grid& grid, std::shared_ptr<const HierarchicalGraph> graph)
+    : m_grid(&grid),
+      m_graph(std::move(graph)),
+      m_inPath(grid.cellCount(), 0)
+{
+    auto startOpt = grid.getStart();
+    auto endOpt   = grid.getEnd();
+
+    if (!startOpt || !endOpt) {
+        m_finished = true;
+        return;
+    }
+
+    reset(*startOpt, *endOpt);
+}
+
+void HPAStarRunner::reset(sf::Vector2i start, sf::Vector2i goal) {
+    for (const auto& p : m_path)
+        m_inPath[m_grid->cellIndex(p.x, p.y)] = 0;
+    m_path.clear();
+    m_nodes.clear();
+    m_open.clear();
+    m_startEdges.clear();
+    m_goalEdges.clear();
+    if (m_changes) m_changes->addAll();
+
+    m_finished = false;
+    m_pathFound = false;
+    m_pathCost = 0;
+    m_visitedCount = 0;
+    m_openMaxSize  = 0;
+    m_pathLength   = 0;
+
+    // na zidu, izven mreže ali v različnih komponentah: poti ni, grafa ne preiščemo
+    if (!m_grid->connected(start, goal)) {
+        m_finished = true;
+        return;
+    }
+
+    m_start = start;
+    m_goal  = goal;
+    m_startCell = m_grid->cellIndex(start.x, start.y);
+    m_goalCell  = m_grid->cellIndex(goal.x, goal.y);
+
+    // start in cilj povežemo z vozlišči svojih gruč (cilj v obratni smeri)
+    const int before = HierarchicalGraph::expanded(m_scratch);
+    m_graph->connect(start, false, goal, m_scratch, m_startEdges);
+    std::vector<std::pair<int, int>> toGoal;
+    m_graph->connect(goal, true, start, m_scratch, toGoal);
+    for (const auto& [node, cost] : toGoal)
+        if (node != m_goalCell)
+            m_goalEdges.emplace(node, cost);
+    m_visitedCount = HierarchicalGraph::expanded(m_scratch) - before;
+
+    m_nodes[m_startCell] = NodeInfo{0, -1, Open};
+    m_open.push_back({std::abs(start.x - goal.x) + std::abs(start.y - goal.y), m_startCell});
+    m_openMaxSize = 1;
+}
+
+bool HPAStarRunner::step() {
+    if (m_finished)
+        return true;
+
+    const auto greater = std::greater<std::pair<int, int>>{};
+    int u = -1;
+    while (!m_open.empty()) {
+        std::pop_heap(m_open.begin(), m_open.end(), greater);
+        const int cell = m_open.back().second;
+        m_open.pop_back();
+        // lazy deletion: zastarel vnos za že zaprto vozlišče
+        if (m_nodes[cell].state == Open) {
+            u = cell;
+            break;
+        }
+    }
+
+    if (u == -1) {
+        m_finished = true;
+        return true;
+    }
+
+    m_nodes[u].state = Closed;
+    logChange(u);
+    ++m_visitedCount;
+
+    if (u == m_goalCell) {
+        m_finished = true;
+        m_pathFound = true;
+        buildPath();
+        return true;
+    }
+
+    if (u == m_startCell)
+        for (const auto& [v, cost] : m_startEdges)
+            relax(u, v, cost);
+    m_graph->forEachEdge(u, [&](int v, int cost) { relax(u, v, cost); });
+    if (auto it = m_goalEdges.find(u); it != m_goalEdges.end())
+        relax(u, m_goalCell, it->second);
+
+    // v enem frame-u obdelamo eno vozlišče
+    return false;
+}
+
+void HPAStarRunner::relax(int from, int to, int cost) {
+    const int g = m_nodes[from].g + cost;
+    NodeInfo& n = m_nodes[to];
+    if (n.state == Closed || g >= n.g)
+        return;
+
+    n.g = g;
+    n.parent = from;
+    if (n.state != Open) logChange(to);
+    n.state = Open;
+
+    const sf::Vector2i p = m_grid->cellPos(to);
+    const int h = std::abs(p.x - m_goal.x) + std::abs(p.y - m_goal.y);
+    m_open.push_back({g + h, to});
+    std::push_heap(m_open.begin(), m_open.end(), std::greater<std::pair<int, int>>{});
+    m_openMaxSize = std::max(m_openMaxSize, static_cast<int>(m_open.size()));
+}
+
+void HPAStarRunner::buildPath() {
+    for (const auto& p : m_path) {
+        m_inPath[m_grid->cellIndex(p.x, p.y)] = 0;
+        logChange(m_grid->cellIndex(p.x, p.y));
+    }
+    m_path.clear();
+
+    // abstraktna pot od cilja nazaj
+    std::vector<int> abstractPath;
+    for (int c = m_goalCell; c != -1; c = m_nodes[c].parent)
+        abstractPath.push_back(c);
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    // vsako povezavo razgradimo v celice: prehod čez mejo je en korak,
+    // povezava znotraj gruče se znova poišče lokalno
+    const int before = HierarchicalGraph::expanded(m_scratch);
+    m_path.push_back(m_start);
+    m_pathCost = 0;
+    for (std::size_t i = 1; i < abstractPath.size(); ++i) {
+        const int a = abstractPath[i - 1];
+        const int b = abstractPath[i];
+        const sf::Vector2i pa = m_grid->cellPos(a);
+        const sf::Vector2i pb = m_grid->cellPos(b);
+        if (m_graph->clusterOf(pa.x, pa.y) != m_graph->clusterOf(pb.x, pb.y)) {
+            m_path.push_back(pb);
+            m_pathCost += m_grid->costAt(b);
+        } else {
+            m_pathCost += m_graph->refine(a, b, m_scratch, m_path);
+        }
+    }
+    m_visitedCount += HierarchicalGraph::expanded(m_scratch) - before;
+
+    for (const auto& p : m_path) {
+        m_inPath[m_grid->cellIndex(p.x, p.y)] = 1;
+        logChange(m_grid->cellIndex(p.x, p.y));
+    }
+    m_pathLength = static_cast<int>(m_path.size());
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "Grid.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ThreadPool;
+
+// Abstraktni graf za HPA* (Botea, Müller, Schaeffer). Mreža je razdeljena na
+// gruče ClusterSize x ClusterSize. Na meji dveh gruč vsak niz celic, ki so
+// prosti na obeh straneh, dobi vhod: en par celic na sredini niza ali dva
+// para na koncih, če je niz daljši. Celice vhodov so vozlišča grafa; med
+// vozlišči iste gruče so shranjene razdalje (lokalna Dijkstra znotraj gruče),
+// med paroma vhoda pa korak čez mejo.
+//
+// Cene so iste kot pri TerrainCost (vstop v celico stane njen teren), zato so
+// povezave usmerjene. Pot čez graf je skoraj optimalna: vozlišča so le
+// izbrane celice meje, zato je lahko nekoliko daljša od poti A*.
+//
+// Po spremembah mreže update() znova zgradi samo gruče, ki vsebujejo
+// spremenjene celice, in sosede, katerih skupna meja se je spremenila.
+class HierarchicalGraph {
+public:
+    static constexpr int DefaultClusterSize = 16;
+    static constexpr int INF = std::numeric_limits<int>::max();
+
+    // threads = 0 pomeni std::thread::hardware_concurrency()
+    explicit HierarchicalGraph(const Grid& grid, int clusterSize = DefaultClusterSize,
+                               int threads = 0);
+    ~HierarchicalGraph();
+
+    HierarchicalGraph(const HierarchicalGraph&) = delete;
+    HierarchicalGraph& operator=(const HierarchicalGraph&) = delete;
+
+    // celoten graf znova (npr. po generateMaze() ali clearAll())
+    void rebuild();
+
+    // ponoven izračun po spremembi celic changed (zid, teren)
+    void update(std::span<const sf::Vector2i> changed);
+
+    const Grid& grid() const { return *m_grid; }
+    int clusterSize() const { return m_clusterSize; }
+    int clusterCount() const { return static_cast<int>(m_clusters.size()); }
+    int nodeCount() const;
+    int clustersRebuilt() const { return m_clustersRebuilt; } // v zadnjem rebuild()/update()
+
+    int clusterOf(int gx, int gy) const {
+        return (gy / m_clusterSize) * m_clustersX + gx / m_clusterSize;
+    }
+
+    bool isNode(int cell) const { return findNode(cell) != nullptr; }
+
+    // usmerjene povezave iz vozlišča cell (indeks Grid::cellIndex): visit(celica, cena)
+    template <class Visit>
+    void forEachEdge(int cell, Visit&& visit) const {
+        const Node* node = findNode(cell);
+        if (!node) return;
+        const Cluster& c = clusterAt(cell);
+        const int n = static_cast<int>(c.nodes.size());
+        const int i = static_cast<int>(node - c.nodes.data());
+        for (int j = 0; j < n; ++j) {
+            const int d = c.dist[i * n + j];
+            if (j != i && d != INF)
+                visit(c.nodes[j].cell, d);
+        }
+        for (int across : node->across)
+            if (across != -1)
+                visit(across, m_grid->costAt(across));
+    }
+
+    // za risanje: vozlišča in povezave znotraj gruč (vsak par enkrat) v
+    // gručah, ki sekajo celice od from do to (vključno); privzeto vse
+    template <class F>
+    void forEachNode(F&& f, sf::Vector2i from = {0, 0},
+                     sf::Vector2i to = {std::numeric_limits<int>::max(), std::numeric_limits<int>::max()}) const {
+        forEachClusterIn(from, to, [&](const Cluster& c) {
+            for (const Node& node : c.nodes)
+                f(m_grid->cellPos(node.cell));
+        });
+    }
+
+    template <class F>
+    void forEachIntraEdge(F&& f, sf::Vector2i from = {0, 0},
+                          sf::Vector2i to = {std::numeric_limits<int>::max(), std::numeric_limits<int>::max()}) const {
+        forEachClusterIn(from, to, [&](const Cluster& c) {
+            const int n = static_cast<int>(c.nodes.size());
+            for (int i = 0; i < n; ++i)
+                for (int j = i + 1; j < n; ++j)
+                    if (c.dist[i * n + j] != INF)
+                        f(m_grid->cellPos(c.nodes[i].cell), m_grid->cellPos(c.nodes[j].cell));
+        });
+    }
+
+    // Pomožna polja za iskanje znotraj ene gruče; vsak uporabnik (nit, runner)
+    // ima svoja, zato je graf med poizvedbami samo za branje.
+    class LocalSearch {
+    public:
+        LocalSearch() = default;
+
+    private:
+        friend class HierarchicalGraph;
+        std::vector<int> dist;   // po lokalnem indeksu gruče
+        std::vector<int> parent; // lokalni indeks ali -1
+        std::vector<std::pair<int, int>> heap; // (razdalja, lokalni indeks)
+        int expanded = 0;
+    };
+
+    // Razdalje od cell do vseh vozlišč njene gruče (reverse = false) ali od
+    // vozlišč do cell (reverse = true), samo po celicah gruče: out dobi pare
+    // (vozlišče, cena). Če je other v isti gruči, je zraven tudi other.
+    void connect(sf::Vector2i cell, bool reverse, sf::Vector2i other, LocalSearch& scratch,
+                 std::vector<std::pair<int, int>>& out) const;
+
+    // najcenejša pot od from do to znotraj gruče celice from; celice (brez
+    // from) doda na konec out in vrne ceno ali INF
+    int refine(int from, int to, LocalSearch& scratch, std::vector<sf::Vector2i>& out) const;
+
+    // razširjene celice v lokalnih iskanjih z danim scratch (za statistiko)
+    static int expanded(const LocalSearch& scratch) { return scratch.expanded; }
+
+private:
+    // ena celica vhoda; across so pari čez mejo (vogalna celica ima lahko dva)
+    struct Node {
+        int cell;
+        int across[2] = {-1, -1};
+    };
+
+    struct Cluster {
+        int x0 = 0, y0 = 0; // prva celica
+        int x1 = 0, y1 = 0; // zadnja celica (vključno)
+        std::vector<Node> nodes;
+        std::vector<int> dist; // nodes.size()^2, dist[i * n + j] od i do j
+    };
+
+    const Grid* m_grid = nullptr;
+    int m_clusterSize = 0;
+    int m_clustersX = 0;
+    int m_clustersY = 0;
+
+    std::vector<Cluster> m_clusters;
+    // vhodi na vzhodni in južni meji gruče: (celica v gruči, celica v sosedu)
+    std::vector<std::vector<std::pair<int, int>>> m_east;
+    std::vector<std::vector<std::pair<int, int>>> m_south;
+
+    std::unique_ptr<ThreadPool> m_pool;
+    std::vector<LocalSearch> m_scratch; // ena na nit bazena
+    int m_clustersRebuilt = 0;
+
+    const Cluster& clusterAt(int cell) const {
+        const sf::Vector2i p = m_grid->cellPos(cell);
+        return m_clusters[clusterOf(p.x, p.y)];
+    }
+
+    const Node* findNode(int cell) const;
+
+    template <class F>
+    void forEachClusterIn(sf::Vector2i from, sf::Vector2i to, F&& f) const {
+        const int cx0 = std::max(0, from.x / m_clusterSize);
+        const int cy0 = std::max(0, from.y / m_clusterSize);
+        const int cx1 = std::min(m_clustersX - 1, to.x / m_clusterSize);
+        const int cy1 = std::min(m_clustersY - 1, to.y / m_clusterSize);
+        for (int cy = cy0; cy <= cy1; ++cy)
+            for (int cx = cx0; cx <= cx1; ++cx)
+                f(m_clusters[cy * m_clustersX + cx]);
+    }
+
+    void buildEastBorder(int k);
+    void buildSouthBorder(int k);
+    void buildCluster(int k, LocalSearch& scratch);
+    void rebuildClusters(const std::vector<int>& clusters);
+
+    // Dijkstra od celice source po celicah gruče c; reverse obrne smer povezav
+    void localDijkstra(const Cluster& c, int source, bool reverse, int target,
+                       LocalSearch& scratch) const;
+};
+
+// HPA* v vmesniku SearchRunner: vsak step() razširi eno vozlišče abstraktnega
+// grafa (start in cilj sta vanj dodana kot začasni vozlišči), na koncu se
+// vsaka povezava poti razgradi v celice z iskanjem znotraj gruče.
+// isOpen/isClosed pokažeta abstraktna vozlišča, getVisitedCount() šteje
+// abstraktne razširitve in celice lokalnih iskanj.
+class HPAStarRunner {
+public:
+    explicit HPAStarRunner(const Grid& grid);
+
+    // graf je lahko skupen več runnerjem (mora biti zgrajen za isto mrežo)
+    HPAStarRunner(const Grid& grid, std::shared_ptr<const HierarchicalGraph> graph);
+
+    // novo iskanje od start do goal na isti mreži (kot SearchRunner::reset)
+    void reset(sf::Vector2i start, sf::Vector2i goal);
+
+    // izvede en korak (razširi eno abstraktno vozlišče); vrne true, ko je algoritem končan
+    bool step();
+
+    // zapis spremenjenih celic za izris (kot SearchRunner::setChangeLog)
+    void setChangeLog(ChangeLog* log) { m_changes = log; }
+
+    bool isFinished() const { return m_finished; }
+    bool hasPath()    const { return m_pathFound; }
+
+    bool isOpen(int gx, int gy) const   { return nodeState(gx, gy) == Open; }
+    bool isClosed(int gx, int gy) const { return nodeState(gx, gy) == Closed; }
+    bool isInPath(int gx, int gy) const {
+        return m_grid->inBounds(gx, gy) && m_inPath[m_grid->cellIndex(gx, gy)];
+    }
+
+    int getPathCost() const { return m_pathFound ? m_pathCost : -1; }
+
+    const std::vector<sf::Vector2i>& getPath() const { return m_path; }
+
+    // statistika za HUD
+    int getVisitedCount() const { return m_visitedCount; }
+    int getOpenMaxSize()  const { return m_openMaxSize;  }
+    int getPathLength()   const { return m_pathLength;   }
+
+    const HierarchicalGraph& graph() const { return *m_graph; }
+
+    static constexpr int INF = std::numeric_limits<int>::max();
+
+private:
+    // microbenchmark meri buildPath() posebej
+    friend struct RunnerBenchAccess;
+
+    enum State : std::uint8_t { None, Open, Closed };
+
+    struct NodeInfo {
+        int g = INF;
+        int parent = -1;
+        State state = None;
+    };
+
+    const Grid* m_grid = nullptr;
+    std::shared_ptr<const HierarchicalGraph> m_graph;
+    HierarchicalGraph::LocalSearch m_scratch;
+
+    sf::Vector2i m_start{};
+    sf::Vector2i m_goal{};
+    int m_startCell = -1;
+    int m_goalCell  = -1;
+
+    std::unordered_map<int, NodeInfo> m_nodes;      // abstraktna vozlišča iskanja
+    std::vector<std::pair<int, int>> m_open;        // (f, celica), kopica z lazy deletion
+    std::vector<std::pair<int, int>> m_startEdges;  // (vozlišče, cena) od starta
+    std::unordered_map<int, int> m_goalEdges;       // vozlišče -> cena do cilja
+
+    std::vector<std::uint8_t> m_inPath;
+    std::vector<sf::Vector2i> m_path;
+    ChangeLog* m_changes = nullptr;
+
+    bool m_finished = false;
+    bool m_pathFound = false;
+    int m_pathCost = 0;
+
+    // števci za HUD
+    int m_visitedCount = 0;
+    int m_openMaxSize  = 0;
+    int m_pathLength   = 0;
+
+    State nodeState(int gx, int gy) const {
+        if (!m_grid->inBounds(gx, gy)) return None;
+        auto it = m_nodes.find(m_grid->cellIndex(gx, gy));
+        return it == m_nodes.end() ? None : it->second.state;
+    }
+
+    void logChange(int cell) {
+        if (m_changes) m_changes->add(cell);
+    }
+
+    void relax(int from, int to, int cost);
+    void buildPath(); // abstraktna pot -> celice
+};
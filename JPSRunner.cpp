@@ -0,0 +1,64 @@
+#include "JPSRunner.hpp"
+
+template class SearchRunner<HeapOpenList, JumpPointNeighbors, UnitCost, ManhattanHeuristic>;
+template class SearchRunner<HeapOpenList, JumpPointPlusNeighbors, UnitCost, ManhattanHeuristic>;
+
+namespace {
+
+// razdalja iz celice, če je sosed n v isti smeri prost in ni skakalna točka
+int extend(int fromNeighbor) {
+    return fromNeighbor > 0 ? fromNeighbor + 1 : fromNeighbor - 1;
+}
+
+} // namespace
+
+JumpPointTable::JumpPointTable(const Grid& grid)
+    : m_dist(grid.cellCount(), std::array<std::int16_t, Count>{0, 0, 0, 0})
+{
+    const int cols = grid.getCols();
+    const int rows = grid.getRows();
+
+    auto at = [&](int gx, int gy) -> std::array<std::int16_t, Count>& {
+        return m_dist[grid.cellIndex(gx, gy)];
+    };
+
+    // vodoravni skoki: vzhod od desne proti levi, zahod od leve proti desni
+    for (int y = 0; y < rows; ++y) {
+        for (int x = cols - 1; x >= 0; --x) {
+            const int nx = x + 1;
+            int d = 0;
+            if (!grid.isWall(nx, y))
+                d = forcedHorizontal(grid, nx, y, 1) ? 1 : extend(at(nx, y)[East]);
+            at(x, y)[East] = static_cast<std::int16_t>(d);
+        }
+        for (int x = 0; x < cols; ++x) {
+            const int nx = x - 1;
+            int d = 0;
+            if (!grid.isWall(nx, y))
+                d = forcedHorizontal(grid, nx, y, -1) ? 1 : extend(at(nx, y)[West]);
+            at(x, y)[West] = static_cast<std::int16_t>(d);
+        }
+    }
+
+    // navpični skoki se ustavijo tudi v vrstici, kjer vodoravni skok najde točko
+    auto stopsVertical = [&](int x, int y, int dy) {
+        return forcedVertical(grid, x, y, dy) || at(x, y)[East] > 0 || at(x, y)[West] > 0;
+    };
+
+    for (int x = 0; x < cols; ++x) {
+        for (int y = rows - 1; y >= 0; --y) {
+            const int ny = y + 1;
+            int d = 0;
+            if (!grid.isWall(x, ny))
+                d = stopsVertical(x, ny, 1) ? 1 : extend(at(x, ny)[South]);
+            at(x, y)[South] = static_cast<std::int16_t>(d);
+        }
+        for (int y = 0; y < rows; ++y) {
+            const int ny = y - 1;
+            int d = 0;
+            if (!grid.isWall(x, ny))
+                d = stopsVertical(x, ny, -1) ? 1 : extend(at(x, ny)[North]);
+            at(x, y)[North] = static_cast<std::int16_t>(d);
+        }
+    }
+}
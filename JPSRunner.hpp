@@ -0,0 +1,181 @@
+#pragma once
+
+#include "SearchRunner.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+
+// Jump Point Search za 4-sosedsko mrežo z enako ceno korakov.
+//
+// Namesto sosedov razširimo samo "skakalne točke". Vodoravni skok se ustavi
+// na cilju ali ko se ob njem za zidom odpre navpični prehod (vsiljen sosed).
+// Navpični skok se ustavi na cilju, pri vsiljenem sosedu ali v vrstici, iz
+// katere vodoravni skok najde skakalno točko ali cilj. Iz točke, dosežene
+// vodoravno, skačemo gor/dol/naprej, iz točke, dosežene navpično,
+// levo/desno/naprej, iz starta v vse štiri smeri. Dolžine poti so enake kot
+// pri A*, razširjenih vozlišč je veliko manj.
+struct JumpPointRules {
+    static constexpr int Count = 4;
+    static constexpr sf::Vector2i Dirs[Count] = {
+        { 1,  0},
+        {-1,  0},
+        { 0,  1},
+        { 0, -1}
+    };
+
+    enum Dir { East = 0, West = 1, South = 2, North = 3 };
+
+    // smeri, v katere skačemo iz pos glede na smer prihoda (-1 za start)
+    static unsigned successorDirs(const Grid& grid, sf::Vector2i pos, int parentDir) {
+        unsigned dirs = 0xFu;
+        if (parentDir != -1) {
+            const unsigned across = Dirs[parentDir].y == 0 ? 1u << South | 1u << North
+                                                           : 1u << East | 1u << West;
+            dirs = 1u << parentDir | across;
+        }
+        return dirs & grid.openNeighbors4(pos.x, pos.y);
+    }
+
+    // vsiljen sosed pri vodoravnem premiku v (x, y) iz smeri dx
+    static bool forcedHorizontal(const Grid& grid, int x, int y, int dx) {
+        return (!grid.isWall(x, y - 1) && grid.isWall(x - dx, y - 1)) ||
+               (!grid.isWall(x, y + 1) && grid.isWall(x - dx, y + 1));
+    }
+
+    // vsiljen sosed pri navpičnem premiku v (x, y) iz smeri dy
+    static bool forcedVertical(const Grid& grid, int x, int y, int dy) {
+        return (!grid.isWall(x - 1, y) && grid.isWall(x - 1, y - dy)) ||
+               (!grid.isWall(x + 1, y) && grid.isWall(x + 1, y - dy));
+    }
+};
+
+// JPS: skoke računamo sproti s pregledom celic
+class JumpPointNeighbors : public JumpPointRules {
+public:
+    explicit JumpPointNeighbors(const Grid&) {}
+
+    template <class Visit>
+    void forEach(const Grid& grid, sf::Vector2i pos, int cell, int parentDir,
+                 sf::Vector2i goal, Visit&& visit) const {
+        const int w = grid.paddedCols();
+        const int offsets[Count] = {1, -1, w, -w};
+
+        unsigned dirs = successorDirs(grid, pos, parentDir);
+        while (dirs) {
+            const int dir = std::countr_zero(dirs);
+            dirs &= dirs - 1;
+
+            const int steps = (Dirs[dir].x != 0)
+                ? jumpHorizontal(grid, pos.x, pos.y, Dirs[dir].x, goal)
+                : jumpVertical(grid, pos.x, pos.y, Dirs[dir].y, goal);
+            if (steps > 0)
+                visit(cell + offsets[dir] * steps, dir, steps);
+        }
+    }
+
+    // število korakov do skakalne točke ali 0, če je ni pred zidom
+    static int jumpHorizontal(const Grid& grid, int x, int y, int dx, sf::Vector2i goal) {
+        for (int steps = 1;; ++steps) {
+            x += dx;
+            if (grid.isWall(x, y)) return 0;
+            if (x == goal.x && y == goal.y) return steps;
+            if (forcedHorizontal(grid, x, y, dx)) return steps;
+        }
+    }
+
+    static int jumpVertical(const Grid& grid, int x, int y, int dy, sf::Vector2i goal) {
+        for (int steps = 1;; ++steps) {
+            y += dy;
+            if (grid.isWall(x, y)) return 0;
+            if (x == goal.x && y == goal.y) return steps;
+            if (forcedVertical(grid, x, y, dy)) return steps;
+            if (jumpHorizontal(grid, x, y, 1, goal) || jumpHorizontal(grid, x, y, -1, goal))
+                return steps;
+        }
+    }
+};
+
+// Tabela skokov za JPS+: za vsako celico in smer razdalja do naslednje
+// skakalne točke (> 0) ali -(število prostih celic do zidu) (<= 0), brez
+// upoštevanja cilja. Odvisna je samo od zidov, zato jo lahko več iskanj na
+// isti mreži deli; po spremembi zidov jo je treba zgraditi znova.
+// Razdalje so int16, zato stranica mreže ne sme preseči 32767 celic.
+class JumpPointTable : public JumpPointRules {
+public:
+    explicit JumpPointTable(const Grid& grid);
+
+    int distance(int cell, int dir) const { return m_dist[cell][dir]; }
+
+private:
+    std::vector<std::array<std::int16_t, Count>> m_dist; // po Grid::cellIndex
+};
+
+// JPS+: skoki so vpogled v JumpPointTable, cilj preverimo posebej
+class JumpPointPlusNeighbors : public JumpPointRules {
+public:
+    JumpPointPlusNeighbors(const Grid&, std::shared_ptr<const JumpPointTable> table)
+        : m_table(std::move(table)) {}
+
+    template <class Visit>
+    void forEach(const Grid& grid, sf::Vector2i pos, int cell, int parentDir,
+                 sf::Vector2i goal, Visit&& visit) const {
+        const int w = grid.paddedCols();
+        const int offsets[Count] = {1, -1, w, -w};
+
+        unsigned dirs = successorDirs(grid, pos, parentDir);
+        while (dirs) {
+            const int dir = std::countr_zero(dirs);
+            dirs &= dirs - 1;
+
+            const int steps = jump(grid, pos, cell, dir, goal);
+            if (steps > 0)
+                visit(cell + offsets[dir] * steps, dir, steps);
+        }
+    }
+
+private:
+    std::shared_ptr<const JumpPointTable> m_table;
+
+    int jump(const Grid& grid, sf::Vector2i pos, int cell, int dir, sf::Vector2i goal) const {
+        const int dist  = m_table->distance(cell, dir);
+        const int reach = dist > 0 ? dist : -dist; // prosta razdalja v tej smeri
+        int best = dist > 0 ? dist : 0;
+
+        const sf::Vector2i d = Dirs[dir];
+        if (d.y == 0) {
+            // cilj v isti vrstici pred naslednjo skakalno točko
+            const int k = (goal.x - pos.x) * d.x;
+            if (goal.y == pos.y && k > 0 && k <= reach)
+                best = k;
+        } else {
+            // navpični skok se ustavi v vrstici cilja, če je cilj od tam viden vodoravno
+            const int k = (goal.y - pos.y) * d.y;
+            if (k > 0 && k <= reach && grid.rowSpanOpen(goal.y, pos.x, goal.x))
+                best = k;
+        }
+        return best;
+    }
+};
+
+using JPSSearch = SearchRunner<HeapOpenList, JumpPointNeighbors, UnitCost, ManhattanHeuristic>;
+extern template class SearchRunner<HeapOpenList, JumpPointNeighbors, UnitCost, ManhattanHeuristic>;
+
+using JPSPlusSearch = SearchRunner<HeapOpenList, JumpPointPlusNeighbors, UnitCost, ManhattanHeuristic>;
+extern template class SearchRunner<HeapOpenList, JumpPointPlusNeighbors, UnitCost, ManhattanHeuristic>;
+
+// Runner za JPS (teren ignorira, vsi koraki stanejo 1)
+class JPSRunner : public JPSSearch {
+public:
+    using JPSSearch::JPSSearch;
+};
+
+// Runner za JPS+; brez tabele jo zgradi sam, za več iskanj na isti mreži
+// je bolje podati skupno tabelo
+class JPSPlusRunner : public JPSPlusSearch {
+public:
+    explicit JPSPlusRunner(const Grid& grid)
+        : JPSPlusSearch(grid, std::make_shared<const JumpPointTable>(grid)) {}
+
+    JPSPlusRunner(const Grid& grid, std::shared_ptr<const JumpPointTable> table)
+        : JPSPlusSearch(grid, std::move(table)) {}
+};
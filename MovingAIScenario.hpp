@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Scenariji MovingAI (.scen, https://movingai.com/benchmarks/formats.html):
+// vrstica "version 1" in nato po ena poizvedba na vrstico
+//
+//   bucket  map  mapWidth  mapHeight  startX  startY  goalX  goalY  optimalLength
+//
+// optimalLength je dolžina najkrajše 8-sosedske poti (diagonala sqrt(2), brez
+// rezanja vogalov). Vrstice brez "version" glave (stara oblika) so enake.
+struct Scenario {
+    int bucket = 0;
+    std::string map;        // pot do .map, kot je zapisana v datoteki
+    int mapWidth = 0;
+    int mapHeight = 0;
+    sf::Vector2i start;
+    sf::Vector2i goal;
+    double optimalLength = 0.0;
+};
+
+// Ob napaki vrne nullopt in, če error ni nullptr, vanj zapiše opis (z vrstico).
+inline std::optional<std::vector<Scenario>> parseScenarios(const std::string& text,
+                                                           std::string* error = nullptr) {
+    std::vector<Scenario> out;
+    std::istringstream in(text);
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line.starts_with("version"))
+            continue;
+
+        std::istringstream fields(line);
+        Scenario s;
+        if (!(fields >> s.bucket >> s.map >> s.mapWidth >> s.mapHeight
+                     >> s.start.x >> s.start.y >> s.goal.x >> s.goal.y >> s.optimalLength)) {
+            if (error)
+                *error = "line " + std::to_string(lineNo) + ": malformed scenario";
+            return std::nullopt;
+        }
+        out.push_back(std::move(s));
+    }
+    return out;
+}
+
+inline std::optional<std::vector<Scenario>> loadScenarios(const std::filesystem::path& path,
+                                                          std::string* error = nullptr) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        if (error)
+            *error = "cannot open " + path.string();
+        return std::nullopt;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+
+    std::string parseError;
+    auto scenarios = parseScenarios(text.str(), &parseError);
+    if (!scenarios && error)
+        *error = path.string() + ": " + parseError;
+    return scenarios;
+}
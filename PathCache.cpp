@@ -0,0 +1,125 @@
+#include "PathCache.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// splitmix64 končni korak
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+std::uint64_t pack(sf::Vector2i p) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(p.x)) << 32) |
+           static_cast<std::uint32_t>(p.y);
+}
+
+} // namespace
+
+std::size_t PathCache::KeyHash::operator()(const PathCacheKey& k) const {
+    std::uint64_t h = mix(pack(k.start));
+    h = mix(h ^ pack(k.goal));
+    h = mix(h ^ k.epoch ^ (static_cast<std::uint64_t>(k.algorithm) << 48));
+    return static_cast<std::size_t>(h);
+}
+
+PathCache::PathCache(const Grid& grid, std::size_t capacity)
+    : m_grid(&grid),
+      m_capacity(std::max<std::size_t>(capacity, 1)),
+      m_epoch(grid.epoch())
+{
+    m_entries.reserve(m_capacity);
+    m_index.reserve(m_capacity);
+}
+
+const PathResult* PathCache::find(sf::Vector2i start, sf::Vector2i goal, std::uint32_t algorithm) {
+    syncEpoch();
+    const auto it = m_index.find(PathCacheKey{start, goal, m_epoch, algorithm});
+    if (it == m_index.end()) {
+        ++m_misses;
+        return nullptr;
+    }
+    ++m_hits;
+    const int i = it->second;
+    if (i != m_head) {
+        unlink(i);
+        pushFront(i);
+    }
+    return &m_entries[i].result;
+}
+
+const PathResult& PathCache::insert(sf::Vector2i start, sf::Vector2i goal, std::uint32_t algorithm,
+                                    PathResult result) {
+    syncEpoch();
+    const PathCacheKey key{start, goal, m_epoch, algorithm};
+
+    // isti ključ: samo zamenjamo rezultat
+    if (const auto it = m_index.find(key); it != m_index.end()) {
+        const int i = it->second;
+        m_entries[i].result = std::move(result);
+        if (i != m_head) {
+            unlink(i);
+            pushFront(i);
+        }
+        return m_entries[i].result;
+    }
+
+    int i;
+    if (m_entries.size() < m_capacity) {
+        i = static_cast<int>(m_entries.size());
+        m_entries.emplace_back();
+    } else {
+        // poln: ponovno uporabimo mesto najdlje neuporabljenega
+        i = m_tail;
+        unlink(i);
+        m_index.erase(m_entries[i].key);
+        ++m_evictions;
+    }
+
+    Entry& e = m_entries[i];
+    e.key = key;
+    e.result = std::move(result);
+    pushFront(i);
+    m_index.emplace(key, i);
+    return e.result;
+}
+
+void PathCache::clear() {
+    m_entries.clear();
+    m_index.clear();
+    m_head = None;
+    m_tail = None;
+}
+
+void PathCache::syncEpoch() {
+    if (m_grid->epoch() == m_epoch)
+        return;
+    m_invalidations += m_index.size();
+    clear();
+    m_epoch = m_grid->epoch();
+}
+
+void PathCache::unlink(int i) {
+    Entry& e = m_entries[i];
+    if (e.prev != None) m_entries[e.prev].next = e.next;
+    else                m_head = e.next;
+    if (e.next != None) m_entries[e.next].prev = e.prev;
+    else                m_tail = e.prev;
+    e.prev = None;
+    e.next = None;
+}
+
+void PathCache::pushFront(int i) {
+    Entry& e = m_entries[i];
+    e.prev = None;
+    e.next = m_head;
+    if (m_head != None) m_entries[m_head].prev = i;
+    m_head = i;
+    if (m_tail == None) m_tail = i;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "BatchPathfinder.hpp"
+#include "Grid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ključ shranjene poti; algorithm je številka, ki jo izbere klicatelj (isti
+// runner z drugimi argumenti konstruktorja, npr. CornerCutting, potrebuje
+// drugo številko)
+struct PathCacheKey {
+    sf::Vector2i start;
+    sf::Vector2i goal;
+    std::uint64_t epoch = 0;
+    std::uint32_t algorithm = 0;
+
+    bool operator==(const PathCacheKey&) const = default;
+};
+
+// Omejen LRU predpomnilnik rezultatov iskanja za eno mrežo, po ključu
+// (start, cilj, Grid::epoch(), algoritem). Zadetek je ena poizvedba v
+// zgoščeni tabeli in premik na začetek seznama, brez alokacij in brez
+// kopiranja poti. Ko se epoch mreže spremeni, so vsi shranjeni rezultati
+// zastareli in se ob naslednjem klicu zavržejo naenkrat (invalidations()).
+//
+// Kazalec oz. referenca na rezultat velja do naslednjega insert(), clear()
+// ali urejanja mreže. Razred ni varen za hkratno uporabo iz več niti.
+class PathCache {
+public:
+    static constexpr std::size_t DefaultCapacity = 4096;
+
+    explicit PathCache(const Grid& grid, std::size_t capacity = DefaultCapacity);
+
+    // shranjen rezultat ali nullptr (šteje zadetek oz. zgrešitev)
+    const PathResult* find(sf::Vector2i start, sf::Vector2i goal, std::uint32_t algorithm);
+
+    // shrani rezultat za trenutni epoch; če je poln, zavrže najdlje neuporabljen
+    const PathResult& insert(sf::Vector2i start, sf::Vector2i goal, std::uint32_t algorithm,
+                             PathResult result);
+
+    // shranjen rezultat ali novo iskanje z runnerjem (reset + step do konca)
+    template <class Runner>
+    const PathResult& findPath(Runner& runner, sf::Vector2i start, sf::Vector2i goal,
+                               std::uint32_t algorithm) {
+        if (const PathResult* hit = find(start, goal, algorithm))
+            return *hit;
+
+        runner.reset(start, goal);
+        while (!runner.step()) {}
+
+        PathResult r;
+        r.found = runner.hasPath();
+        r.cost = runner.getPathCost();
+        r.visited = runner.getVisitedCount();
+        r.path = runner.getPath();
+        return insert(start, goal, algorithm, std::move(r));
+    }
+
+    void clear();
+
+    std::size_t size()     const { return m_index.size(); }
+    std::size_t capacity() const { return m_capacity; }
+
+    // števci od konstrukcije ali resetStats() (za izbiro kapacitete)
+    std::uint64_t hits()          const { return m_hits; }
+    std::uint64_t misses()        const { return m_misses; }
+    std::uint64_t evictions()     const { return m_evictions; }     // zavrženi zaradi kapacitete
+    std::uint64_t invalidations() const { return m_invalidations; } // zavrženi zaradi urejanja mreže
+    double hitRate() const {
+        const std::uint64_t total = m_hits + m_misses;
+        return total > 0 ? static_cast<double>(m_hits) / static_cast<double>(total) : 0.0;
+    }
+    void resetStats() { m_hits = m_misses = m_evictions = m_invalidations = 0; }
+
+private:
+    static constexpr int None = -1;
+
+    struct KeyHash {
+        std::size_t operator()(const PathCacheKey& k) const;
+    };
+
+    // vozlišča LRU seznama v vektorju (povezave so indeksi), da zadetek ne alocira
+    struct Entry {
+        PathCacheKey key;
+        PathResult result;
+        int prev = None;
+        int next = None;
+    };
+
+    const Grid* m_grid = nullptr;
+    std::size_t m_capacity = 0;
+    std::uint64_t m_epoch = 0; // epoch mreže, za katerega veljajo vnosi
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<PathCacheKey, int, KeyHash> m_index;
+    int m_head = None; // nazadnje uporabljen
+    int m_tail = None; // najdlje neuporabljen
+
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+    std::uint64_t m_evictions = 0;
+    std::uint64_t m_invalidations = 0;
+
+    // zavrže vse vnose, če se je mreža od zadnjega klica spremenila
+    void syncEpoch();
+
+    void unlink(int i);
+    void pushFront(int i);
+};
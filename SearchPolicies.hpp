@@ -0,0 +1,444 @@
+#pragma once
+
+#include "Grid.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Politike za SearchRunner. Vse metode so inline/statične, da se v step()
+// prevedejo brez klicev. Celice so indeksi iz Grid::cellIndex().
+
+// ---------------------------------------------------------------------------
+// Seznami odprtih vozlišč: push(cell, key, g), pop() vrne celico z najmanjšim
+// key. Seznam sme vsebovati zastarele zapise; SearchRunner jih ob pop()
+// preskoči (celica je že zaprta). Key je tip ključa in g; SearchRunner
+// zahteva, da je enak tipu cene modela cen.
+
+// Vsi seznami se zgradijo s številom celic (Grid::cellCount()), clear() jih
+// izprazni za novo iskanje brez sproščanja pomnilnika.
+
+// FIFO vrsta za BFS (key in g se ne uporabljata)
+class FifoOpenList {
+public:
+    using Key = int;
+
+    explicit FifoOpenList(int /*cellCount*/) {}
+
+    bool empty() const { return m_head == m_items.size(); }
+    int  size()  const { return static_cast<int>(m_items.size() - m_head); }
+
+    void push(int cell, int /*key*/, int /*g*/) { m_items.push_back(cell); }
+    int  pop() { return m_items[m_head++]; }
+
+    void clear() {
+        m_items.clear();
+        m_head = 0;
+    }
+
+private:
+    // vsaka celica pride v vrsto največ enkrat, zato je ravno polje dovolj
+    std::vector<int> m_items;
+    std::size_t m_head = 0;
+};
+
+// binarna kopica (min po key) z lazy deletion; std::int64_t ključi za
+// oktilne cene (HeapOpenList64)
+template <class KeyType>
+class BasicHeapOpenList {
+public:
+    using Key = KeyType;
+
+    explicit BasicHeapOpenList(int /*cellCount*/) {}
+
+    bool empty() const { return m_heap.empty(); }
+    int  size()  const { return static_cast<int>(m_heap.size()); }
+
+    void push(int cell, Key key, Key /*g*/) {
+        m_heap.push_back(Entry{key, cell});
+        std::push_heap(m_heap.begin(), m_heap.end(), Compare{});
+    }
+
+    int pop() {
+        std::pop_heap(m_heap.begin(), m_heap.end(), Compare{});
+        int cell = m_heap.back().cell;
+        m_heap.pop_back();
+        return cell;
+    }
+
+    void clear() { m_heap.clear(); }
+
+private:
+    struct Entry {
+        Key key;
+        int cell;
+    };
+    struct Compare {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.key > b.key; // manjši key ima prednost
+        }
+    };
+    std::vector<Entry> m_heap;
+};
+
+using HeapOpenList = BasicHeapOpenList<int>;
+using HeapOpenList64 = BasicHeapOpenList<std::int64_t>;
+
+// Bucket queue (Dial) za cele ključe, ki ob pop() ne padajo (Dijkstra,
+// A* s konsistentno hevristiko). Vedra so dvojno povezani seznami v poljih
+// po celicah, razporejeni v krožni tabeli, ki zraste, ko razpon ključev
+// preseže njeno velikost. Ponovni push() celico premakne v novo vedro, zato
+// seznam nima zastarelih zapisov in size() šteje samo odprte celice.
+// Znotraj vedra je LIFO: pri enakem f ima prednost nazadnje dodana celica,
+// ki ima pri A* večji g (je bližje cilju).
+class BucketOpenList {
+public:
+    using Key = int;
+
+    explicit BucketOpenList(int cellCount)
+        : m_next(cellCount, None),
+          m_prev(cellCount, None),
+          m_key(cellCount, None),
+          m_heads(InitialBuckets, None),
+          m_mask(InitialBuckets - 1) {}
+
+    bool empty() const { return m_size == 0; }
+    int  size()  const { return m_size; }
+
+    void push(int cell, int key, int /*g*/) {
+        if (m_key[cell] != None)
+            unlink(cell); // boljši ključ za celico, ki je že v seznamu
+        else
+            ++m_size;
+
+        // ključi so vedno >= zadnjemu pop(), zato m_current nastavimo samo enkrat
+        if (m_current == None)
+            m_current = key;
+        if (key - m_current > m_mask)
+            grow(key - m_current);
+
+        link(cell, key);
+    }
+
+    int pop() {
+        while (m_heads[m_current & m_mask] == None)
+            ++m_current;
+
+        const int cell = m_heads[m_current & m_mask];
+        unlink(cell);
+        m_key[cell] = None;
+        --m_size;
+        return cell;
+    }
+
+    // ponastavi samo celice, ki so še v vedrih
+    void clear() {
+        for (int& head : m_heads) {
+            for (int cell = head; cell != None; cell = m_next[cell])
+                m_key[cell] = None;
+            head = None;
+        }
+        m_current = None;
+        m_size = 0;
+    }
+
+private:
+    static constexpr int None = -1;
+    static constexpr int InitialBuckets = 16;
+
+    std::vector<int> m_next;  // naslednja celica v istem vedru
+    std::vector<int> m_prev;  // prejšnja celica v istem vedru
+    std::vector<int> m_key;   // ključ celice ali None, če ni v seznamu
+    std::vector<int> m_heads; // prva celica vsakega vedra (krožno po key)
+    int m_mask = 0;           // m_heads.size() - 1
+    int m_current = None;     // najmanjši možni ključ (zadnji pop())
+    int m_size = 0;
+
+    void link(int cell, int key) {
+        int& head = m_heads[key & m_mask];
+        m_key[cell]  = key;
+        m_prev[cell] = None;
+        m_next[cell] = head;
+        if (head != None)
+            m_prev[head] = cell;
+        head = cell;
+    }
+
+    void unlink(int cell) {
+        const int prev = m_prev[cell];
+        const int next = m_next[cell];
+        if (prev != None)
+            m_next[prev] = next;
+        else
+            m_heads[m_key[cell] & m_mask] = next;
+        if (next != None)
+            m_prev[next] = prev;
+    }
+
+    // povečamo krožno tabelo, da pokrije razpon ključev [m_current, m_current + span]
+    void grow(int span) {
+        std::vector<int> oldHeads;
+        oldHeads.swap(m_heads);
+        const int oldSize = static_cast<int>(oldHeads.size());
+
+        int newSize = oldSize;
+        while (newSize <= span)
+            newSize *= 2;
+        m_heads.assign(newSize, None);
+        m_mask = newSize - 1;
+
+        // vsako vedro prenesemo od repa proti glavi, da ostane LIFO vrstni red
+        for (int i = 0; i < oldSize; ++i) {
+            int tail = oldHeads[i];
+            if (tail == None)
+                continue;
+            while (m_next[tail] != None)
+                tail = m_next[tail];
+            for (int cell = tail; cell != None;) {
+                const int prev = m_prev[cell];
+                link(cell, m_key[cell]);
+                cell = prev;
+            }
+        }
+    }
+};
+
+// Radix heap za cele ključe, ki ob pop() ne padajo. Ključ je v vedru po
+// najvišjem bitu, v katerem se razlikuje od zadnjega pop(), zato ima vsak
+// zapis največ 32 premikov med vedri. Primeren za utežene mreže, kjer
+// bucket queue zaradi velikega razpona ključev izgubi prednost.
+// Ima lazy deletion kot HeapOpenList.
+class RadixHeapOpenList {
+public:
+    using Key = int;
+
+    explicit RadixHeapOpenList(int /*cellCount*/) {}
+
+    bool empty() const { return m_size == 0; }
+    int  size()  const { return m_size; }
+
+    void push(int cell, int key, int /*g*/) {
+        const auto k = static_cast<std::uint32_t>(key);
+        m_buckets[bucketOf(k)].push_back(Entry{k, cell});
+        ++m_size;
+    }
+
+    int pop() {
+        if (m_buckets[0].empty()) {
+            // prvo neprazno vedro razdelimo glede na njegov najmanjši ključ
+            int i = 1;
+            while (m_buckets[i].empty())
+                ++i;
+
+            std::uint32_t minKey = m_buckets[i].front().key;
+            for (const Entry& e : m_buckets[i])
+                minKey = std::min(minKey, e.key);
+            m_last = minKey;
+
+            for (const Entry& e : m_buckets[i])
+                m_buckets[bucketOf(e.key)].push_back(e);
+            m_buckets[i].clear();
+        }
+
+        const int cell = m_buckets[0].back().cell;
+        m_buckets[0].pop_back();
+        --m_size;
+        return cell;
+    }
+
+    void clear() {
+        for (auto& bucket : m_buckets)
+            bucket.clear();
+        m_last = 0;
+        m_size = 0;
+    }
+
+private:
+    struct Entry {
+        std::uint32_t key;
+        int cell;
+    };
+
+    std::vector<Entry> m_buckets[33];
+    std::uint32_t m_last = 0; // ključ zadnjega pop()
+    int m_size = 0;
+
+    int bucketOf(std::uint32_t key) const {
+        return static_cast<int>(std::bit_width(key ^ m_last));
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Soseščine se zgradijo z mrežo.
+// forEach(grid, pos, cell, parentDir, goal, visit) pokliče
+// visit(celica, smer, koraki) za vsakega naslednika celice pos;
+// naslednik je koraki * Dirs[smer] od pos (navadni sosedje imajo koraki = 1).
+// parentDir je smer, v kateri je bila celica dosežena (-1 za start), goal je
+// cilj iskanja.
+
+// 4-sosedsko premikanje (gor/dol/levo/desno), vrstni red kot Grid::openNeighbors4
+struct Neighbors4 {
+    static constexpr int Count = 4;
+    static constexpr sf::Vector2i Dirs[Count] = {
+        { 1,  0},
+        {-1,  0},
+        { 0,  1},
+        { 0, -1}
+    };
+
+    explicit Neighbors4(const Grid&) {}
+
+    template <class Visit>
+    void forEach(const Grid& grid, sf::Vector2i pos, int cell, int /*parentDir*/,
+                 sf::Vector2i /*goal*/, Visit&& visit) const {
+        const int w = grid.paddedCols();
+        const int offsets[Count] = {1, -1, w, -w};
+
+        unsigned open = grid.openNeighbors4(pos.x, pos.y);
+        while (open) {
+            const int dir = std::countr_zero(open);
+            open &= open - 1;
+            visit(cell + offsets[dir], dir, 1);
+        }
+    }
+};
+
+// Pravila za diagonalne premike 8-sosedstva. Diagonala med dvema zidovoma
+// ni dovoljena pri nobenem pravilu, zato 8-sosedska pot ne zapusti
+// 4-sosedske komponente in Grid::connected() ostane veljaven.
+enum class CornerCutting {
+    Never,  // obe pravokotni sosednji celici sta prosti (kot scenariji MovingAI)
+    OneSide // vsaj ena pravokotna sosednja celica je prosta (rezanje vogala)
+};
+
+// dovoljeni premiki za vsako masko Grid::openNeighbors8 pri danem pravilu
+constexpr std::array<std::uint8_t, 256> cornerCuttingMoves(CornerCutting rule) {
+    // pravokotni smeri ob diagonali 4 + i: (+1,+1), (-1,-1), (+1,-1), (-1,+1)
+    constexpr int sideX[4] = {0, 1, 0, 1};
+    constexpr int sideY[4] = {2, 3, 3, 2};
+    std::array<std::uint8_t, 256> moves{};
+    for (unsigned mask = 0; mask < 256; ++mask) {
+        unsigned allowed = mask & 0xFu;
+        for (int i = 0; i < 4; ++i) {
+            const bool x = mask & (1u << sideX[i]);
+            const bool y = mask & (1u << sideY[i]);
+            const bool corner = rule == CornerCutting::Never ? (x && y) : (x || y);
+            if ((mask & (1u << (4 + i))) && corner)
+                allowed |= 1u << (4 + i);
+        }
+        moves[mask] = static_cast<std::uint8_t>(allowed);
+    }
+    return moves;
+}
+
+// 8-sosedsko premikanje: smeri 0..3 kot Neighbors4, 4..7 diagonale v vrstnem
+// redu Grid::openNeighbors8 (nasprotni smeri sta d in d ^ 1). Pravilo za
+// vogale se poda konstruktorju (privzeto brez rezanja vogalov); sosede
+// prebere iz predizračunane maske mreže in tabele dovoljenih premikov.
+class Neighbors8 {
+public:
+    static constexpr int Count = 8;
+    static constexpr sf::Vector2i Dirs[Count] = {
+        { 1,  0},
+        {-1,  0},
+        { 0,  1},
+        { 0, -1},
+        { 1,  1},
+        {-1, -1},
+        { 1, -1},
+        {-1,  1}
+    };
+
+    explicit Neighbors8(const Grid&, CornerCutting rule = CornerCutting::Never)
+        : m_rule(rule), m_moves(rule == CornerCutting::Never ? NeverMoves.data() : OneSideMoves.data()) {}
+
+    CornerCutting rule() const { return m_rule; }
+
+    // pred iskanjem (SearchRunner::reset): maske sosedov mreže se zgradijo lenobno
+    static void prepare(const Grid& grid) { grid.refreshNeighborMasks(); }
+
+    template <class Visit>
+    void forEach(const Grid& grid, sf::Vector2i /*pos*/, int cell, int /*parentDir*/,
+                 sf::Vector2i /*goal*/, Visit&& visit) const {
+        const int w = grid.paddedCols();
+        const int offsets[Count] = {1, -1, w, -w, w + 1, -w - 1, -w + 1, w - 1};
+
+        unsigned open = m_moves[grid.neighborMask8(cell)];
+        while (open) {
+            const int dir = std::countr_zero(open);
+            open &= open - 1;
+            visit(cell + offsets[dir], dir, 1);
+        }
+    }
+
+private:
+    static constexpr std::array<std::uint8_t, 256> NeverMoves = cornerCuttingMoves(CornerCutting::Never);
+    static constexpr std::array<std::uint8_t, 256> OneSideMoves = cornerCuttingMoves(CornerCutting::OneSide);
+
+    CornerCutting m_rule;
+    const std::uint8_t* m_moves;
+};
+
+// ---------------------------------------------------------------------------
+// Cene premikov: cost(grid, ciljna celica, smer); tip vrnjene cene je tudi
+// tip g in ključev runnerja
+
+// vsak korak ima enako ceno 1
+struct UnitCost {
+    static int cost(const Grid&, int /*cell*/, int /*dir*/) { return 1; }
+};
+
+// cena vstopa v celico je njen teren (Grid::getCost, 1..255); najmanjša
+// cena je 1, zato Manhattan hevristika ostane dopustna
+struct TerrainCost {
+    static int cost(const Grid& grid, int cell, int /*dir*/) { return grid.costAt(cell); }
+};
+
+// 8-sosedske cene v fiksni vejici: raven korak stane Straight, diagonalni
+// Diagonal enot (smeri >= 4 pri Neighbors8 so diagonale)
+struct Octile10 {
+    static constexpr int Straight = 10;
+    static constexpr int Diagonal = 14; // hiter približek sqrt(2)
+};
+struct OctileExact {
+    static constexpr int Straight = 408;
+    static constexpr int Diagonal = 577; // 577 / 408 se od sqrt(2) razlikuje za 2e-6
+};
+
+// Cena vstopa je teren celice, pomnožen z dolžino koraka v enotah Units.
+// Pot na mreži 4096x4096 ima lahko milijone korakov po do 255 * 577, kar
+// ne gre v int, zato je cena (in z njo g runnerja) std::int64_t.
+template <class Units>
+struct OctileTerrainCost {
+    static std::int64_t cost(const Grid& grid, int cell, int dir) {
+        return std::int64_t{grid.costAt(cell)} * (dir < 4 ? Units::Straight : Units::Diagonal);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Hevristike: estimate(x, y, ciljX, ciljY)
+
+// brez hevristike (BFS, Dijkstra)
+struct ZeroHeuristic {
+    static int estimate(int, int, int, int) { return 0; }
+};
+
+// Manhattan razdalja (dela dobro za 4-sosedsko mrežo)
+struct ManhattanHeuristic {
+    static int estimate(int x, int y, int tx, int ty) {
+        return std::abs(x - tx) + std::abs(y - ty);
+    }
+};
+
+// oktilna razdalja za 8-sosedsko mrežo v enotah Units (dopustna, ker je
+// najmanjša cena terena 1)
+template <class Units>
+struct OctileHeuristic {
+    static int estimate(int x, int y, int tx, int ty) {
+        const int dx = std::abs(x - tx);
+        const int dy = std::abs(y - ty);
+        return Units::Diagonal * std::min(dx, dy) + Units::Straight * (std::max(dx, dy) - std::min(dx, dy));
+    }
+};
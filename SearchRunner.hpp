@@ -0,0 +1,317 @@
+#pragma once
+
+#include "Grid.hpp"
+#include "SearchPolicies.hpp"
+#include "SearchWorkspace.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Skupno jedro BFS/Dijkstra/A*, ki teče po korakih (primerno za animacijo).
+// Algoritem določijo politike ob prevajanju:
+//   OpenList     - vrstni red razširjanja (FIFO, kopica, bucket queue)
+//   Neighborhood - kateri sosedje (ali skoki, JPS) so dosegljivi iz celice
+//   CostModel    - cena premika na sosednjo celico
+//   Heuristic    - ocena preostale cene do cilja (0 = Dijkstra/BFS)
+// Stanje je v SearchWorkspace (po Grid::cellIndex()), ki si ga runner skupaj z
+// open listom izposodi iz WorkspacePool; nov runner ali reset() zato ne
+// alocira in ne briše polj velikosti mreže.
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+class SearchRunner {
+public:
+    // tip g (int, pri oktilnih cenah std::int64_t)
+    using Cost = decltype(CostModel::cost(std::declval<const Grid&>(), 0, 0));
+    using Workspace = BasicSearchWorkspace<Cost>;
+
+    // dodatni argumenti gredo v konstruktor soseščine (npr. tabela skokov za JPS+);
+    // če ima mreža start in end, se iskanje takoj pripravi zanju
+    template <class... NeighborhoodArgs>
+    explicit SearchRunner(const Grid& grid, NeighborhoodArgs&&... neighborhoodArgs);
+
+    // novo iskanje od start do goal na isti mreži v O(1) (nova generacija
+    // delovnega prostora, prazen open list)
+    void reset(sf::Vector2i start, sf::Vector2i goal);
+
+    // zgradi lene indekse mreže, ki jih iskanje bere (komponente, maske
+    // soseščine), da jih lahko runnerji na več nitih potem samo berejo
+    static void prepareGrid(const Grid& grid) {
+        grid.refreshComponents();
+        if constexpr (requires { Neighborhood::prepare(grid); })
+            Neighborhood::prepare(grid);
+    }
+
+    // izvede en korak (razširi eno vozlišče); vrne true, ko je algoritem končan
+    bool step();
+
+    // celice, ki jim se spremeni open/closed/path, se zapišejo v log (izris);
+    // reset() zapiše "vse". nullptr izklopi zapisovanje.
+    void setChangeLog(ChangeLog* log) { m_changes = log; }
+
+    bool isFinished() const { return m_finished; }
+    bool hasPath()    const { return m_pathFound; }
+
+    bool isOpen(int gx, int gy) const   { return hasFlag(gx, gy, Open); }
+    bool isClosed(int gx, int gy) const { return hasFlag(gx, gy, Closed); }
+    bool isInPath(int gx, int gy) const { return hasFlag(gx, gy, InPath); }
+
+    Cost getGScore(int gx, int gy) const {
+        if (!inBounds(gx, gy)) return INF;
+        return m_ws->g(m_grid->cellIndex(gx, gy));
+    }
+
+    // skupna cena najdene poti (g cilja), -1 če poti ni
+    Cost getPathCost() const { return m_pathFound ? m_ws->g(m_endCell) : -1; }
+
+    // najdena pot od starta do cilja (prazna, če je ni)
+    const std::vector<sf::Vector2i>& getPath() const { return m_path; }
+
+    // statistika za HUD
+    int getVisitedCount() const { return m_visitedCount; }
+    int getOpenMaxSize()  const { return m_openMaxSize;  }
+    int getPathLength()   const { return m_pathLength;   }
+
+    static constexpr Cost INF = Workspace::INF;
+
+private:
+    // microbenchmark meri buildPath() posebej
+    friend struct RunnerBenchAccess;
+
+    enum Flag : std::uint8_t {
+        Open   = 1 << 0,
+        Closed = 1 << 1,
+        InPath = 1 << 2
+    };
+
+    const Grid* m_grid = nullptr;
+    int m_rows = 0;
+    int m_cols = 0;
+
+    sf::Vector2i m_start{};
+    sf::Vector2i m_end{};
+    int m_startCell = -1;
+    int m_endCell   = -1;
+
+    typename WorkspacePool<Workspace>::Lease m_ws; // g, smer starša, Open/Closed/InPath
+    typename WorkspacePool<OpenList>::Lease m_open;
+    std::vector<sf::Vector2i> m_path;
+    ChangeLog* m_changes = nullptr;
+
+    Neighborhood m_neighborhood;
+
+    bool m_finished = false;
+    bool m_pathFound = false;
+
+    // števci za HUD
+    int m_visitedCount = 0;
+    int m_openMaxSize  = 0;
+    int m_pathLength   = 0;
+
+    bool inBounds(int gx, int gy) const {
+        return gx >= 0 && gx < m_cols && gy >= 0 && gy < m_rows;
+    }
+
+    bool hasFlag(int gx, int gy, Flag flag) const {
+        if (!inBounds(gx, gy)) return false;
+        return m_ws->flags(m_grid->cellIndex(gx, gy)) & flag;
+    }
+
+    void logChange(int cell) {
+        if (m_changes) m_changes->add(cell);
+    }
+
+    void pushOpen(typename Workspace::Cell& c, int cell, Cost key) {
+        m_open->push(cell, key, c.g);
+        if (!(c.flags & Open)) logChange(cell);
+        c.flags |= Open;
+        m_openMaxSize = std::max(m_openMaxSize, m_open->size());
+    }
+
+    static_assert(Neighborhood::Count <= Workspace::MaxDirs);
+    static_assert(std::is_same_v<typename OpenList::Key, Cost>,
+                  "open list keys must have the cost model's type");
+
+    // starš celice z znanim g: prva celica v nasprotni smeri prihoda, iz
+    // katere je premik do cell dal njen g (pri navadnih sosedih je to
+    // sosednja celica, pri skoku JPS izhodišče skoka ali enako dober
+    // zaprt del skoka); -1 za start
+    int parentOf(int cell) const;
+
+    void buildPath(); // sledenje parentov nazaj do starta
+};
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+template <class... NeighborhoodArgs>
+SearchRunner<OpenList, Neighborhood, CostModel, Heuristic>::SearchRunner(
+    const Grid& grid, NeighborhoodArgs&&... neighborhoodArgs)
+    : m_grid(&grid),
+      m_rows(grid.getRows()),
+      m_cols(grid.getCols()),
+      m_ws(WorkspacePool<Workspace>::shared().acquire(grid.cellCount())),
+      m_open(WorkspacePool<OpenList>::shared().acquire(grid.cellCount())),
+      m_neighborhood(grid, std::forward<NeighborhoodArgs>(neighborhoodArgs)...)
+{
+    auto startOpt = grid.getStart();
+    auto endOpt   = grid.getEnd();
+
+    if (!startOpt || !endOpt) {
+        m_finished = true;
+        return;
+    }
+
+    reset(*startOpt, *endOpt);
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+void SearchRunner<OpenList, Neighborhood, CostModel, Heuristic>::reset(
+    sf::Vector2i start, sf::Vector2i goal)
+{
+    m_ws->clear();
+    m_open->clear();
+    m_path.clear();
+    if (m_changes) m_changes->addAll();
+
+    m_finished = false;
+    m_pathFound = false;
+    m_visitedCount = 0;
+    m_openMaxSize  = 0;
+    m_pathLength   = 0;
+
+    m_start = start;
+    m_end   = goal;
+    m_startCell = -1;
+    m_endCell   = -1;
+
+    // če je start ali end izven mreže ali na zidu ali sta v različnih
+    // komponentah, nima smisla iskati poti (indeks komponent odgovori v O(1))
+    if (!inBounds(start.x, start.y) || !inBounds(goal.x, goal.y) ||
+        !m_grid->connected(start, goal)) {
+        m_finished = true;
+        return;
+    }
+
+    if constexpr (requires { Neighborhood::prepare(*m_grid); })
+        Neighborhood::prepare(*m_grid);
+
+    m_startCell = m_grid->cellIndex(start.x, start.y);
+    m_endCell   = m_grid->cellIndex(goal.x, goal.y);
+
+    typename Workspace::Cell& c = m_ws->cell(m_startCell);
+    c.g = 0;
+    pushOpen(c, m_startCell, Heuristic::estimate(start.x, start.y, goal.x, goal.y));
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+bool SearchRunner<OpenList, Neighborhood, CostModel, Heuristic>::step() {
+    if (m_finished || !m_grid)
+        return true;
+
+    while (!m_open->empty()) {
+        const int cur = m_open->pop();
+        typename Workspace::Cell& curCell = m_ws->cell(cur);
+
+        // zastarel zapis (celica je bila že razširjena z boljšo ceno)
+        if (curCell.flags & Closed)
+            continue;
+
+        curCell.flags = static_cast<std::uint8_t>((curCell.flags & ~Open) | Closed);
+        logChange(cur);
+        ++m_visitedCount;
+
+        if (cur == m_endCell) {
+            m_finished = true;
+            m_pathFound = true;
+            buildPath();
+            return true;
+        }
+
+        const sf::Vector2i pos = m_grid->cellPos(cur);
+        const Cost g = curCell.g;
+
+        // steps > 1 pomeni skok v ravni črti (JPS); cena je enaka vsoti korakov
+        auto relax = [&](int next, int dir, int steps) {
+            // nedotaknjena celica ima g = INF, zato jo vsak sosed izboljša
+            typename Workspace::Cell& n = m_ws->cell(next);
+            if (n.flags & Closed)
+                return;
+
+            const Cost tentativeG = g + CostModel::cost(*m_grid, next, dir) * steps;
+            if (tentativeG >= n.g)
+                return;
+
+            n.g = tentativeG;
+            n.setParentDir(dir);
+
+            const int nx = pos.x + Neighborhood::Dirs[dir].x * steps;
+            const int ny = pos.y + Neighborhood::Dirs[dir].y * steps;
+            pushOpen(n, next, tentativeG + Heuristic::estimate(nx, ny, m_end.x, m_end.y));
+        };
+        m_neighborhood.forEach(*m_grid, pos, cur, curCell.parentDir(), m_end, relax);
+
+        // v enem frame-u obdelamo eno vozlišče
+        return false;
+    }
+
+    // open set je prazen, poti ni
+    m_finished = true;
+    m_pathFound = false;
+    return true;
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+int SearchRunner<OpenList, Neighborhood, CostModel, Heuristic>::parentOf(int cell) const {
+    const int dir = m_ws->parentDir(cell);
+    if (dir == -1)
+        return -1;
+
+    const sf::Vector2i d = Neighborhood::Dirs[dir];
+    const int back = -(d.x + d.y * m_grid->paddedCols());
+    const Cost g = m_ws->g(cell);
+    const Cost stepCost = CostModel::cost(*m_grid, cell, dir);
+
+    // skok gre samo čez proste celice in se začne v zaprti celici z
+    // g + koraki * cena == g(cell), zato se zanka ustavi najkasneje tam
+    int p = cell + back;
+    for (int steps = 1; !(m_ws->flags(p) & Closed) || m_ws->g(p) + stepCost * steps != g; ++steps)
+        p += back;
+    return p;
+}
+
+template <class OpenList, class Neighborhood, class CostModel, class Heuristic>
+void SearchRunner<OpenList, Neighborhood, CostModel, Heuristic>::buildPath() {
+    // počistimo samo celice prejšnje poti
+    for (const auto& p : m_path) {
+        m_ws->cell(m_grid->cellIndex(p.x, p.y)).flags &= static_cast<std::uint8_t>(~InPath);
+        logChange(m_grid->cellIndex(p.x, p.y));
+    }
+    m_path.clear();
+
+    // sledenje parentov od cilja nazaj do starta; pri skokih (JPS) starš ni
+    // sosednja celica, zato vmesne celice dopolnimo po ravni črti
+    int cur = m_endCell;
+    while (cur != -1) {
+        m_ws->cell(cur).flags |= InPath;
+        logChange(cur);
+        m_path.push_back(m_grid->cellPos(cur));
+        if (cur == m_startCell) break;
+
+        const int parent = parentOf(cur);
+        if (parent == -1) break;
+
+        const sf::Vector2i from = m_grid->cellPos(cur);
+        const sf::Vector2i to   = m_grid->cellPos(parent);
+        const int sx = (to.x > from.x) - (to.x < from.x);
+        const int sy = (to.y > from.y) - (to.y < from.y);
+        for (sf::Vector2i p{from.x + sx, from.y + sy}; p != to; p.x += sx, p.y += sy) {
+            m_ws->cell(m_grid->cellIndex(p.x, p.y)).flags |= InPath;
+            logChange(m_grid->cellIndex(p.x, p.y));
+            m_path.push_back(p);
+        }
+        cur = parent;
+    }
+
+    std::reverse(m_path.begin(), m_path.end());
+    m_pathLength = static_cast<int>(m_path.size());
+}
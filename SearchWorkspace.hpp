@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Stanje iskanja po celicah (g, smer starša, zastavice) z generacijskim
+// žigom. clear() samo poveča generacijo, zato je ponastavitev za naslednjo
+// poizvedbo O(1): celica z žigom stare generacije se bere kot nedotaknjena
+// (g = INF, brez starša, brez zastavic) in se ponastavi ob prvem zapisu.
+//
+// Zapis celice je 8 bajtov: g ter žig, zastavice in smer starša v eni
+// 32-bitni besedi. Namesto indeksa starša hranimo smer, v kateri je bila
+// celica dosežena (indeks v Neighborhood::Dirs); starš je v nasprotni smeri,
+// pri skokih (JPS) nekaj celic stran, zato ga runner poišče po g (glej
+// SearchRunner::parentOf). Mreža 4096x4096 tako potrebuje 128 MB namesto 256.
+//
+// G je tip cene (g); int zadošča za 4-sosedske cene terena, oktilne cene
+// (OctileTerrainCost, do 577 na korak) pa potrebujejo std::int64_t in zapis
+// 16 bajtov.
+template <class G>
+class BasicSearchWorkspace {
+public:
+    static constexpr G INF = std::numeric_limits<G>::max();
+    static constexpr int StampBits = 24;
+    static constexpr int MaxDirs = 15; // smer 0..14, 0 v zapisu pomeni "brez starša"
+
+    struct Cell {
+        G g = INF;
+        std::uint32_t stamp : StampBits = 0; // generacija zadnjega zapisa
+        std::uint32_t flags : 4 = 0;         // pomen določi runner
+        std::uint32_t dirCode : 4 = 0;       // smer prihoda + 1, 0 = brez starša
+
+        int parentDir() const { return static_cast<int>(dirCode) - 1; }
+        void setParentDir(int dir) { dirCode = static_cast<std::uint32_t>(dir + 1); }
+    };
+
+    static_assert(sizeof(Cell) == (sizeof(G) == 4 ? 8 : 16));
+
+    explicit BasicSearchWorkspace(int cellCount) : m_cells(cellCount) {}
+
+    int cellCount() const { return static_cast<int>(m_cells.size()); }
+
+    // vse celice so spet nedotaknjene
+    void clear() {
+        if (++m_generation == 1u << StampBits) {
+            // po 2^24 poizvedbah žige enkrat zares počistimo
+            for (Cell& c : m_cells)
+                c.stamp = 0;
+            m_generation = 1;
+        }
+    }
+
+    bool touched(int cell) const { return m_cells[cell].stamp == m_generation; }
+
+    std::uint8_t flags(int cell) const {
+        return touched(cell) ? static_cast<std::uint8_t>(m_cells[cell].flags) : 0;
+    }
+    G g(int cell) const           { return touched(cell) ? m_cells[cell].g : INF; }
+    int parentDir(int cell) const { return touched(cell) ? m_cells[cell].parentDir() : -1; }
+
+    // zapis celice v trenutni generaciji (ob prvem dostopu dobi privzete vrednosti)
+    Cell& cell(int cell) {
+        Cell& c = m_cells[cell];
+        if (c.stamp != m_generation) {
+            c = Cell{};
+            c.stamp = m_generation;
+        }
+        return c;
+    }
+
+private:
+    std::vector<Cell> m_cells; // po Grid::cellIndex
+    std::uint32_t m_generation = 1;
+};
+
+using SearchWorkspace = BasicSearchWorkspace<int>;
+
+// Bazen objektov, ki se zgradijo s številom celic (SearchWorkspace, open
+// listi). Runner si ob konstrukciji izposodi objekt prave velikosti in ga ob
+// uničenju vrne, zato nov runner na isti mreži ne alocira nič; izposojen
+// objekt je že počiščen (clear()). Bazen je varen za več niti.
+template <class T>
+class WorkspacePool {
+public:
+    class Release {
+    public:
+        Release() = default;
+        Release(WorkspacePool* pool, int cellCount) : m_pool(pool), m_cellCount(cellCount) {}
+        void operator()(T* item) const { m_pool->give(m_cellCount, item); }
+
+    private:
+        WorkspacePool* m_pool = nullptr;
+        int m_cellCount = 0;
+    };
+
+    using Lease = std::unique_ptr<T, Release>;
+
+    // skupen bazen za tip T; namenoma ni nikoli uničen, da so izposoje veljavne
+    // tudi iz statičnih objektov ob izhodu programa
+    static WorkspacePool& shared() {
+        static WorkspacePool* pool = new WorkspacePool();
+        return *pool;
+    }
+
+    Lease acquire(int cellCount) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+                if (it->cellCount == cellCount) {
+                    T* item = it->item.release();
+                    m_free.erase(it);
+                    item->clear();
+                    return Lease(item, Release(this, cellCount));
+                }
+            }
+        }
+        return Lease(new T(cellCount), Release(this, cellCount));
+    }
+
+private:
+    // več prostih objektov ni smiselno hraniti (vsak je velik kot mreža)
+    static constexpr std::size_t MaxFree = 8;
+
+    struct Entry {
+        int cellCount;
+        std::unique_ptr<T> item;
+    };
+
+    std::mutex m_mutex;
+    std::vector<Entry> m_free; // najstarejši na začetku
+
+    void give(int cellCount, T* item) {
+        Entry entry{cellCount, std::unique_ptr<T>(item)};
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_free.size() == MaxFree)
+            m_free.erase(m_free.begin());
+        m_free.push_back(std::move(entry));
+    }
+};
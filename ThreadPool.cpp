@@ -0,0 +1,135 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0)
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(threads, 1);
+
+    for (int i = 0; i < threads; ++i)
+        m_ranges.push_back(std::make_unique<Range>());
+
+    // nit 0 je klicatelj parallelFor()
+    for (int i = 1; i < threads; ++i)
+        m_threads.emplace_back([this, i] { loop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_threads)
+        t.join();
+}
+
+void ThreadPool::parallelFor(int count, const Job& job, int grain) {
+    if (count <= 0)
+        return;
+    grain = std::max(grain, 1);
+
+    if (m_threads.empty() || count <= grain) {
+        for (int i = 0; i < count; ++i)
+            job(0, i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> run(m_runMutex);
+
+    const int n = size();
+    for (int w = 0; w < n; ++w) {
+        Range& r = *m_ranges[w];
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.begin = static_cast<int>(static_cast<long long>(count) * w / n);
+        r.end   = static_cast<int>(static_cast<long long>(count) * (w + 1) / n);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_grain = grain;
+        m_pending = static_cast<int>(m_threads.size());
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    m_job = nullptr;
+}
+
+void ThreadPool::loop(int worker) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop)
+                return;
+            seen = m_generation;
+        }
+
+        work(worker);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0)
+            m_done.notify_one();
+    }
+}
+
+// dela, dokler ni ves obseg porabljen (tudi pri drugih nitih)
+void ThreadPool::work(int worker) {
+    const Job& job = *m_job;
+    int begin = 0;
+    int end = 0;
+    for (;;) {
+        if (takeOwn(worker, begin, end)) {
+            for (int i = begin; i < end; ++i)
+                job(worker, i);
+        } else if (!steal(worker)) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::takeOwn(int worker, int& begin, int& end) {
+    Range& r = *m_ranges[worker];
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (r.begin >= r.end)
+        return false;
+    begin = r.begin;
+    end = std::min(r.end, r.begin + m_grain);
+    r.begin = end;
+    return true;
+}
+
+// ukrade zgornjo polovico preostanka prve niti, ki še ima delo; ko je vse
+// razdeljeno, vrne false (ukradeni indeksi niso nikoli v dveh obsegih)
+bool ThreadPool::steal(int thief) {
+    const int n = size();
+    for (int k = 1; k < n; ++k) {
+        Range& victim = *m_ranges[(thief + k) % n];
+        int begin = 0;
+        int end = 0;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            const int left = victim.end - victim.begin;
+            if (left <= 0)
+                continue;
+            begin = victim.begin + left / 2;
+            end = victim.end;
+            victim.end = begin;
+        }
+
+        Range& own = *m_ranges[thief];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+    return false;
+}
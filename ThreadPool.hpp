@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Bazen niti za parallelFor s krajo dela. Indeksi [0, count) se razdelijo na
+// enake kose, po enega na nit; nit jemlje po grain indeksov s sprednjega
+// konca svojega kosa, ko ga izčrpa, pa drugi niti ukrade zgornjo polovico
+// preostanka. Tako se neenakomerno dolga opravila (npr. poizvedbe poti)
+// sama porazdelijo brez skupne vrste.
+//
+// Klicatelj parallelFor() dela kot nit 0, zato bazen z eno nitjo ne ustvari
+// nobene dodatne niti. Opravilo dobi (worker, index); worker je v [0, size())
+// in ga lahko uporabi za lastne pomožne podatke brez zaklepanja.
+// parallelFor() se ne sme klicati iz opravila istega bazena.
+class ThreadPool {
+public:
+    using Job = std::function<void(int worker, int index)>;
+
+    // threads = 0 pomeni std::thread::hardware_concurrency()
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // število niti, vključno s klicateljem
+    int size() const { return static_cast<int>(m_ranges.size()); }
+
+    // pokliče job(worker, i) za vsak i v [0, count) in počaka, da so vsi končani
+    void parallelFor(int count, const Job& job, int grain = 1);
+
+private:
+    // preostanek kosa ene niti; poravnano, da si niti ne delijo cache linije
+    struct alignas(64) Range {
+        std::mutex mutex;
+        int begin = 0;
+        int end   = 0;
+    };
+
+    std::vector<std::unique_ptr<Range>> m_ranges;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_runMutex; // en parallelFor naenkrat
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const Job* m_job = nullptr;
+    int m_grain = 1;
+    int m_pending = 0;              // pomožne niti, ki še delajo
+    std::uint64_t m_generation = 0; // poveča se ob vsakem parallelFor
+    bool m_stop = false;
+
+    void loop(int worker);
+    void work(int worker);
+    bool takeOwn(int worker, int& begin, int& end);
+    bool steal(int thief);
+};
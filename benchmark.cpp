@@ -0,0 +1,430 @@
+// Headless benchmark za runnerje: brez okna in brez SFML Graphics.
+// Vsak runner teče do konca v tesni zanki, rezultat je CSV ali JSON na stdout.
+//
+// Z --queries N vsak runner namesto ene poti od starta do cilja reši N
+// naključnih poizvedb prek BatchPathfinder na --threads nitih.
+//
+// Primer:
+//   PathfindingBenchmark --map maze --cols 2047 --rows 2047 --seed 7 --repeat 5 --format json
+//   PathfindingBenchmark --map random --cols 1024 --rows 1024 --algo astar --queries 1000 --threads 8
+//   PathfindingBenchmark --map-file maps/den520d.map --algo astar,jps --queries 1000
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Grid.hpp"
+#include "GridFile.hpp"
+#include "BenchMaps.hpp"
+#include "BFSRunner.hpp"
+#include "DijkstraRunner.hpp"
+#include "AStarRunner.hpp"
+#include "JPSRunner.hpp"
+#include "BidirectionalRunner.hpp"
+#include "FloodFillRunner.hpp"
+#include "DStarLiteRunner.hpp"
+#include "HPAStarRunner.hpp"
+#include "BatchPathfinder.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+
+struct BenchOptions {
+    MapKind map = MapKind::Random;
+    MazeAlgorithm maze = MazeAlgorithm::Backtracker; // generator za --map maze
+    int mazeThreads = -1; // -1 = zaporedni generator, sicer po ploščicah (0 = vse niti)
+    std::string mapFile; // če ni prazen, se mreža naloži (.pfg ali MovingAI .map)
+    int cols = 512;
+    int rows = 512;
+    double density = 0.25;
+    int maxCost = 1;
+    std::uint32_t seed = 1;
+    int repeat = 3;
+    int queries = 0; // 0 = ena pot od starta do cilja, sicer paket naključnih poizvedb
+    int threads = 0; // niti za paket, 0 = hardware_concurrency()
+    std::string algos = "bfs,dijkstra,astar,dijkstra-bucket,astar-bucket,"
+                        "dijkstra-radix,astar-radix,jps,jps-plus,bfs-bidir,astar-bidir,bfs-bitset,"
+                        "dstar-lite";
+    bool json = false;
+};
+
+struct BenchResult {
+    std::string algo;
+    int repetition = 0;
+    double constructMs = 0.0; // konstruktor runnerja (alokacije)
+    double searchMs    = 0.0; // vsi klici step()
+    double wallMs      = 0.0; // konstruktor + iskanje
+    double nsPerNode   = 0.0;
+    int visited   = 0;
+    int maxOpen   = 0;
+    int pathLength = 0;
+    std::int64_t pathCost = 0;
+    bool found = false;
+    // pri paketu: visited, pathLength in pathCost so vsote, found = vse poti najdene
+    int queries = 1;
+    int threads = 1;
+    double queriesPerSec = 0.0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double msBetween(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+template <class Runner>
+BenchResult runToCompletion(const char* name, const Grid& grid) {
+    BenchResult r;
+    r.algo = name;
+
+    auto t0 = Clock::now();
+    Runner runner(grid);
+    auto t1 = Clock::now();
+    while (!runner.step()) {
+    }
+    auto t2 = Clock::now();
+
+    r.constructMs = msBetween(t0, t1);
+    r.searchMs    = msBetween(t1, t2);
+    r.wallMs      = msBetween(t0, t2);
+    r.visited     = runner.getVisitedCount();
+    r.maxOpen     = runner.getOpenMaxSize();
+    r.pathLength  = runner.getPathLength();
+    r.pathCost    = runner.getPathCost();
+    r.found       = runner.hasPath();
+    if (r.visited > 0)
+        r.nsPerNode = r.searchMs * 1.0e6 / r.visited;
+    if (r.searchMs > 0.0)
+        r.queriesPerSec = 1000.0 / r.searchMs;
+    return r;
+}
+
+// constructMs je izdelava BatchPathfinder (pri JPS+ tudi skupne tabele skokov,
+// pri HPA* skupnega grafa gruč),
+// runnerji niti nastanejo med iskanjem ob prvi poizvedbi
+template <class Runner>
+BenchResult runBatch(const char* name, const Grid& grid, ThreadPool& pool,
+                     std::span<const PathQuery> queries) {
+    BenchResult r;
+    r.algo = name;
+
+    auto t0 = Clock::now();
+    auto batch = [&] {
+        if constexpr (std::is_same_v<Runner, JPSPlusRunner>)
+            return BatchPathfinder<Runner>(grid, pool,
+                                           std::make_shared<const JumpPointTable>(grid));
+        else if constexpr (std::is_same_v<Runner, HPAStarRunner>)
+            return BatchPathfinder<Runner>(grid, pool,
+                                           std::make_shared<const HierarchicalGraph>(grid));
+        else
+            return BatchPathfinder<Runner>(grid, pool);
+    }();
+    auto t1 = Clock::now();
+    const std::vector<PathResult> results = batch.run(queries);
+    auto t2 = Clock::now();
+
+    r.constructMs = msBetween(t0, t1);
+    r.searchMs    = msBetween(t1, t2);
+    r.wallMs      = msBetween(t0, t2);
+    r.found       = true;
+    for (const PathResult& q : results) {
+        r.visited    += q.visited;
+        r.pathLength += static_cast<int>(q.path.size());
+        r.pathCost   += q.found ? q.cost : 0;
+        r.found       = r.found && q.found;
+    }
+    r.maxOpen = -1; // ni smiselno pri paketu
+    r.queries = static_cast<int>(queries.size());
+    r.threads = pool.size();
+    if (r.visited > 0)
+        r.nsPerNode = r.searchMs * 1.0e6 / r.visited;
+    if (r.searchMs > 0.0)
+        r.queriesPerSec = r.queries * 1000.0 / r.searchMs;
+    return r;
+}
+
+struct AlgoEntry {
+    const char* name;
+    BenchResult (*run)(const char*, const Grid&);
+    BenchResult (*runBatch)(const char*, const Grid&, ThreadPool&, std::span<const PathQuery>);
+};
+
+template <class Runner>
+constexpr AlgoEntry algo(const char* name) {
+    return {name, &runToCompletion<Runner>, &runBatch<Runner>};
+}
+
+const AlgoEntry kAlgos[] = {
+    algo<BFSRunner>("bfs"),
+    algo<DijkstraRunner>("dijkstra"),
+    algo<AStarRunner>("astar"),
+    algo<DijkstraBucketRunner>("dijkstra-bucket"),
+    algo<AStarBucketRunner>("astar-bucket"),
+    algo<DijkstraRadixRunner>("dijkstra-radix"),
+    algo<AStarRadixRunner>("astar-radix"),
+    algo<JPSRunner>("jps"),
+    algo<JPSPlusRunner>("jps-plus"),
+    algo<BidirectionalBFSRunner>("bfs-bidir"),
+    algo<BidirectionalAStarRunner>("astar-bidir"),
+    algo<FloodFillRunner>("bfs-bitset"),
+    algo<DStarLiteRunner>("dstar-lite"),
+    algo<HPAStarRunner>("hpa"),
+    algo<BFS8Runner>("bfs8"),
+    algo<Dijkstra8Runner>("dijkstra8"),
+    algo<AStar8Runner>("astar8"),
+    algo<Dijkstra8ExactRunner>("dijkstra8-exact"),
+    algo<AStar8ExactRunner>("astar8-exact"),
+};
+
+std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty())
+            out.push_back(item);
+    return out;
+}
+
+void printUsage() {
+    std::cerr <<
+        "Usage: PathfindingBenchmark [options]\n"
+        "  --map open|maze|random   map kind (default random)\n"
+        "  --maze backtracker|eller|kruskal|wilson\n"
+        "                           maze generator for --map maze (default backtracker)\n"
+        "  --maze-threads N         generate the maze in parallel tiles on N threads\n"
+        "                           (0 = all cores; same maze for any N)\n"
+        "  --map-file PATH          load a grid file (.pfg) or MovingAI .map instead;\n"
+        "                           cols, rows, density and max-cost are ignored\n"
+        "  --cols N --rows N        grid size (default 512x512)\n"
+        "  --density F              wall density for random maps (default 0.25)\n"
+        "  --max-cost N             random terrain costs 1..N (default 1 = unweighted)\n"
+        "  --seed N                 map generator seed (default 1)\n"
+        "  --repeat N               runs per algorithm (default 3)\n"
+        "  --queries N              solve N random start/goal pairs per run\n"
+        "                           instead of the grid's start/end (default 0)\n"
+        "  --threads N              worker threads for --queries (default 0 = all cores)\n"
+        "  --algo a,b,...           bfs,dijkstra,astar,dijkstra-bucket,astar-bucket,\n"
+        "                           dijkstra-radix,astar-radix,jps,jps-plus,\n"
+        "                           bfs-bidir,astar-bidir,bfs-bitset,dstar-lite,hpa,\n"
+        "                           bfs8,dijkstra8,astar8,dijkstra8-exact,astar8-exact\n"
+        "                           (default all except hpa and the 8-way ones)\n"
+        "  --format csv|json        output format (default csv)\n";
+}
+
+bool parseArgs(int argc, char** argv, BenchOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string key = argv[i];
+        if (key == "--help" || key == "-h")
+            return false;
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << key << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (key == "--map") {
+            auto kind = parseMapKind(value);
+            if (!kind) {
+                std::cerr << "Unknown map kind: " << value << "\n";
+                return false;
+            }
+            opt.map = *kind;
+        } else if (key == "--maze") {
+            auto maze = parseMazeAlgorithm(value);
+            if (!maze) {
+                std::cerr << "Unknown maze generator: " << value << "\n";
+                return false;
+            }
+            opt.maze = *maze;
+        } else if (key == "--maze-threads") {
+            opt.mazeThreads = std::max(std::atoi(value.c_str()), 0);
+        } else if (key == "--map-file") {
+            opt.mapFile = value;
+        } else if (key == "--cols") {
+            opt.cols = std::atoi(value.c_str());
+        } else if (key == "--rows") {
+            opt.rows = std::atoi(value.c_str());
+        } else if (key == "--density") {
+            opt.density = std::atof(value.c_str());
+        } else if (key == "--max-cost") {
+            opt.maxCost = std::atoi(value.c_str());
+        } else if (key == "--seed") {
+            opt.seed = static_cast<std::uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (key == "--repeat") {
+            opt.repeat = std::atoi(value.c_str());
+        } else if (key == "--queries") {
+            opt.queries = std::atoi(value.c_str());
+        } else if (key == "--threads") {
+            opt.threads = std::atoi(value.c_str());
+        } else if (key == "--algo") {
+            opt.algos = value;
+        } else if (key == "--format") {
+            if (value != "csv" && value != "json") {
+                std::cerr << "Unknown format: " << value << "\n";
+                return false;
+            }
+            opt.json = (value == "json");
+        } else {
+            std::cerr << "Unknown option: " << key << "\n";
+            return false;
+        }
+    }
+
+    if (opt.cols <= 0 || opt.rows <= 0 || opt.repeat <= 0) {
+        std::cerr << "cols, rows and repeat must be positive\n";
+        return false;
+    }
+    if (opt.queries < 0 || opt.threads < 0) {
+        std::cerr << "queries and threads must not be negative\n";
+        return false;
+    }
+    if (opt.maxCost < Grid::MinCost || opt.maxCost > Grid::MaxCost) {
+        std::cerr << "max-cost must be between " << Grid::MinCost
+                  << " and " << Grid::MaxCost << "\n";
+        return false;
+    }
+    return true;
+}
+
+// oznaka mape v izpisu: pot do datoteke ali vrsta generirane mape
+// (labirint z drugim generatorjem kot backtracker npr. "maze-eller", po
+// ploščicah s pripono "-tiled")
+std::string mapLabel(const BenchOptions& opt) {
+    if (!opt.mapFile.empty())
+        return opt.mapFile;
+    if (opt.map != MapKind::Maze)
+        return mapKindName(opt.map);
+    std::string label = "maze";
+    if (opt.maze != MazeAlgorithm::Backtracker)
+        label += std::string("-") + mazeAlgorithmName(opt.maze);
+    if (opt.mazeThreads >= 0)
+        label += "-tiled";
+    return label;
+}
+
+void printCsv(const BenchOptions& opt, const std::vector<BenchResult>& results) {
+    std::cout << "algo,map,cols,rows,density,max_cost,seed,rep,found,construct_ms,search_ms,"
+                 "wall_ms,ns_per_node,visited,max_open,path_length,path_cost,"
+                 "queries,threads,queries_per_s\n";
+    for (const auto& r : results) {
+        std::cout << r.algo << ',' << mapLabel(opt) << ','
+                  << opt.cols << ',' << opt.rows << ',' << opt.density << ','
+                  << opt.maxCost << ',' << opt.seed << ',' << r.repetition << ',' << (r.found ? 1 : 0) << ','
+                  << r.constructMs << ',' << r.searchMs << ',' << r.wallMs << ','
+                  << r.nsPerNode << ',' << r.visited << ',' << r.maxOpen << ','
+                  << r.pathLength << ',' << r.pathCost << ','
+                  << r.queries << ',' << r.threads << ',' << r.queriesPerSec << '\n';
+    }
+}
+
+void printJson(const BenchOptions& opt, const std::vector<BenchResult>& results) {
+    std::cout << "{\n"
+              << "  \"map\": \"" << mapLabel(opt) << "\",\n"
+              << "  \"cols\": " << opt.cols << ",\n"
+              << "  \"rows\": " << opt.rows << ",\n"
+              << "  \"density\": " << opt.density << ",\n"
+              << "  \"max_cost\": " << opt.maxCost << ",\n"
+              << "  \"seed\": " << opt.seed << ",\n"
+              << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        std::cout << "    {\"algo\": \"" << r.algo << "\""
+                  << ", \"rep\": " << r.repetition
+                  << ", \"found\": " << (r.found ? "true" : "false")
+                  << ", \"construct_ms\": " << r.constructMs
+                  << ", \"search_ms\": " << r.searchMs
+                  << ", \"wall_ms\": " << r.wallMs
+                  << ", \"ns_per_node\": " << r.nsPerNode
+                  << ", \"visited\": " << r.visited
+                  << ", \"max_open\": " << r.maxOpen
+                  << ", \"path_length\": " << r.pathLength
+                  << ", \"path_cost\": " << r.pathCost
+                  << ", \"queries\": " << r.queries
+                  << ", \"threads\": " << r.threads
+                  << ", \"queries_per_s\": " << r.queriesPerSec
+                  << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    std::cout << "  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage();
+        return 2;
+    }
+
+    std::vector<const AlgoEntry*> selected;
+    for (const auto& name : splitList(opt.algos)) {
+        const AlgoEntry* found = nullptr;
+        for (const auto& entry : kAlgos)
+            if (name == entry.name)
+                found = &entry;
+        if (!found) {
+            std::cerr << "Unknown algorithm: " << name << "\n";
+            printUsage();
+            return 2;
+        }
+        selected.push_back(found);
+    }
+
+    std::optional<Grid> loaded;
+    if (!opt.mapFile.empty()) {
+        std::string error;
+        loaded = loadGrid(opt.mapFile, 1, &error);
+        if (!loaded) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+        opt.cols = loaded->getCols();
+        opt.rows = loaded->getRows();
+        if (opt.queries == 0 && (!loaded->hasStart() || !loaded->hasEnd())) {
+            std::cerr << opt.mapFile << " has no start/end; use --queries N\n";
+            return 2;
+        }
+    }
+    std::unique_ptr<ThreadPool> mazePool;
+    if (!loaded && opt.mazeThreads >= 0)
+        mazePool = std::make_unique<ThreadPool>(opt.mazeThreads);
+    Grid grid = loaded ? std::move(*loaded)
+                       : makeBenchGrid(opt.map, opt.cols, opt.rows, opt.density, opt.seed,
+                                       opt.maxCost, opt.maze, mazePool.get());
+    mazePool.reset();
+
+    // paket: iste poizvedbe za vse algoritme; bazen niti se ustvari enkrat
+    std::vector<PathQuery> queries;
+    std::unique_ptr<ThreadPool> pool;
+    if (opt.queries > 0) {
+        queries = makeBenchQueries(grid, opt.queries, opt.seed);
+        pool = std::make_unique<ThreadPool>(opt.threads);
+    }
+
+    std::vector<BenchResult> results;
+    for (const AlgoEntry* entry : selected) {
+        for (int rep = 0; rep < opt.repeat; ++rep) {
+            BenchResult r = pool ? entry->runBatch(entry->name, grid, *pool, queries)
+                                 : entry->run(entry->name, grid);
+            r.repetition = rep;
+            results.push_back(r);
+        }
+    }
+
+    if (opt.json)
+        printJson(opt, results);
+    else
+        printCsv(opt, results);
+
+    return 0;
+}
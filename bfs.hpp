@@ -53,12 +53,14 @@ inline bool runBFS(const Grid& grid, std::vector<sf::Vector2i>& outPath) {
             break;
         }
 
-        for (const auto& d : dirs) {
-            int nx = cur.x + d.x;
-            int ny = cur.y + d.y;
+        // rob mreže je zid, zato zadošča maska prostih sosedov
+        const unsigned open = grid.openNeighbors4(cur.x, cur.y);
+        for (int i = 0; i < 4; ++i) {
+            if (!(open & (1u << i))) continue;
+
+            int nx = cur.x + dirs[i].x;
+            int ny = cur.y + dirs[i].y;
 
-            if (!grid.inBounds(nx, ny))  continue;
-            if (grid.isWall(nx, ny))     continue;
             if (visited[ny][nx])         continue;
 
             visited[ny][nx] = true;
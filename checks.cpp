@@ -0,0 +1,330 @@
+// Preverjanja pravilnosti, ki jih poganja CTest (ctest v mapi builda). Vsako
+// preverjanje primerja runnerje z neodvisno referenco v tej datoteki, ob
+// napaki izpiše razliko na stderr in vrne izhodno kodo 1.
+//
+//   octile-overflow  8-sosedski Dijkstra/A* na labirintu 4095x4095 s cenami
+//                    terena 1..9: cena poti preseže int, zato mora g runnerja
+//                    biti 64-biten (OctileTerrainCost)
+//   dstar-lite-edits D* Lite po vsakem od 12000 naključnih urejanj (zid, teren,
+//                    start, cilj) popravi pot; cena in pot se ujemata s svežo
+//                    Dijkstro
+//   flowfield-edits  FlowField::update() po vsakem od 1200 naključnih urejanj
+//                    da iste razdalje in smeri kot svež build(); razdalja
+//                    na startu se ujema z Dijkstro
+//
+// Primer:
+//   PathfindingChecks                   (vsa preverjanja)
+//   PathfindingChecks octile-overflow
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Grid.hpp"
+#include "BenchMaps.hpp"
+#include "DijkstraRunner.hpp"
+#include "AStarRunner.hpp"
+#include "DStarLiteRunner.hpp"
+#include "FlowField.hpp"
+
+namespace {
+
+constexpr std::uint32_t kSeed = 1;
+
+// cena koraka v enotah terena; diagonal = 0 pomeni 4-sosedstvo
+struct Moves {
+    int straight = 1;
+    int diagonal = 0;
+};
+
+constexpr Moves kFourWay{1, 0};
+
+// Najcenejša pot (8-sosedska brez rezanja vogalov, če moves.diagonal != 0):
+// vstop v celico stane njen teren * straight oz. * diagonal. Prebere samo
+// isWall/getCost, neodvisno od mask mreže in politik runnerjev. -1, če poti ni.
+std::int64_t referenceCost(const Grid& grid, sf::Vector2i start, sf::Vector2i goal, Moves moves) {
+    if (grid.isWall(start.x, start.y) || grid.isWall(goal.x, goal.y))
+        return -1;
+    auto free = [&](int x, int y) { return grid.inBounds(x, y) && !grid.isWall(x, y); };
+
+    constexpr std::int64_t Unknown = std::numeric_limits<std::int64_t>::max();
+    std::vector<std::int64_t> dist(grid.cellCount(), Unknown);
+    using Entry = std::pair<std::int64_t, int>; // (razdalja, celica)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+
+    const int source = grid.cellIndex(start.x, start.y);
+    const int target = grid.cellIndex(goal.x, goal.y);
+    dist[source] = 0;
+    open.push({0, source});
+    while (!open.empty()) {
+        const auto [d, cell] = open.top();
+        open.pop();
+        if (d != dist[cell])
+            continue;
+        if (cell == target)
+            return d;
+        const sf::Vector2i p = grid.cellPos(cell);
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if ((dx == 0 && dy == 0) || !free(p.x + dx, p.y + dy))
+                    continue;
+                const bool diag = dx != 0 && dy != 0;
+                if (diag && (moves.diagonal == 0 || !free(p.x + dx, p.y) || !free(p.x, p.y + dy)))
+                    continue;
+                const int next = grid.cellIndex(p.x + dx, p.y + dy);
+                const std::int64_t nd = d + std::int64_t{grid.getCost(p.x + dx, p.y + dy)} *
+                                                (diag ? moves.diagonal : moves.straight);
+                if (nd < dist[next]) {
+                    dist[next] = nd;
+                    open.push({nd, next});
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+// cena poti od start do goal po istih pravilih kot referenceCost ali -1,
+// če pot ni veljavna
+std::int64_t walkedCost(const Grid& grid, const std::vector<sf::Vector2i>& path,
+                        sf::Vector2i start, sf::Vector2i goal, Moves moves) {
+    if (path.empty() || path.front() != start || path.back() != goal)
+        return -1;
+    std::int64_t cost = 0;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        const sf::Vector2i p = path[i];
+        const sf::Vector2i d = p - path[i - 1];
+        if (std::abs(d.x) > 1 || std::abs(d.y) > 1 || d == sf::Vector2i{0, 0} ||
+            !grid.inBounds(p.x, p.y) || grid.isWall(p.x, p.y))
+            return -1;
+        const bool diag = d.x != 0 && d.y != 0;
+        if (diag && (moves.diagonal == 0 || grid.isWall(p.x, p.y - d.y) || grid.isWall(p.x - d.x, p.y)))
+            return -1;
+        cost += std::int64_t{grid.getCost(p.x, p.y)} * (diag ? moves.diagonal : moves.straight);
+    }
+    return cost;
+}
+
+template <class Runner, class Units>
+bool checkOctileRunner(const char* name, const Grid& grid, std::int64_t expected) {
+    Runner runner(grid);
+    while (!runner.step()) {
+    }
+    const std::int64_t cost = runner.getPathCost();
+    const std::int64_t walked = walkedCost(grid, runner.getPath(), *grid.getStart(), *grid.getEnd(),
+                                           Moves{Units::Straight, Units::Diagonal});
+    if (cost != expected || walked != expected) {
+        std::cerr << "FAIL octile-overflow " << name << ": cost " << cost << ", path cost " << walked
+                  << ", expected " << expected << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool checkOctileOverflow() {
+    const Grid grid = makeBenchGrid(MapKind::Maze, 4095, 4095, 0.0, kSeed, 9);
+    const sf::Vector2i start = *grid.getStart();
+    const sf::Vector2i goal = *grid.getEnd();
+
+    const std::int64_t exact = referenceCost(grid, start, goal, Moves{OctileExact::Straight, OctileExact::Diagonal});
+    const std::int64_t coarse = referenceCost(grid, start, goal, Moves{Octile10::Straight, Octile10::Diagonal});
+    // sicer preverjanje ne pokrije prekoračitve
+    if (exact <= std::numeric_limits<int>::max()) {
+        std::cerr << "FAIL octile-overflow: reference cost " << exact << " fits in int\n";
+        return false;
+    }
+
+    bool ok = true;
+    ok &= checkOctileRunner<Dijkstra8ExactRunner, OctileExact>("dijkstra8-exact", grid, exact);
+    ok &= checkOctileRunner<AStar8ExactRunner, OctileExact>("astar8-exact", grid, exact);
+    ok &= checkOctileRunner<Dijkstra8Runner, Octile10>("dijkstra8", grid, coarse);
+    ok &= checkOctileRunner<AStar8Runner, Octile10>("astar8", grid, coarse);
+    return ok;
+}
+
+// naključna celica mreže
+sf::Vector2i randomCell(const Grid& grid, std::mt19937& rng) {
+    return {std::uniform_int_distribution<int>(0, grid.getCols() - 1)(rng),
+            std::uniform_int_distribution<int>(0, grid.getRows() - 1)(rng)};
+}
+
+// Naključno urejanje, kot ga naredi risanje v simulatorju: preklop zidu,
+// teren, počiščena celica, premik starta ali (redko) cilja. Zid se ne postavi
+// na start ali cilj. Vrne spremenjeno celico.
+sf::Vector2i randomEdit(Grid& grid, std::mt19937& rng) {
+    const sf::Vector2i c = randomCell(grid, rng);
+    const bool endpoint = grid.isStart(c.x, c.y) || grid.isEnd(c.x, c.y);
+    switch (std::uniform_int_distribution<int>(0, 15)(rng)) {
+        case 0: case 1: case 2: case 3: case 4: case 5:
+            if (!endpoint)
+                grid.setWall(c.x, c.y, !grid.isWall(c.x, c.y));
+            break;
+        case 6: case 7: case 8: case 9:
+            grid.setCost(c.x, c.y, std::uniform_int_distribution<int>(Grid::MinCost, 9)(rng));
+            break;
+        case 10: case 11:
+            grid.clearCell(c.x, c.y);
+            if (endpoint) {
+                // clearCell odstrani start / cilj; postavimo ju nazaj
+                if (!grid.hasStart()) grid.setStart(c.x, c.y);
+                if (!grid.hasEnd())   grid.setEnd(c.x, c.y);
+            }
+            break;
+        case 15:
+            if (!grid.isStart(c.x, c.y))
+                grid.setEnd(c.x, c.y);
+            break;
+        default:
+            if (!grid.isEnd(c.x, c.y))
+                grid.setStart(c.x, c.y);
+            break;
+    }
+    return c;
+}
+
+bool checkDStarLiteEdits() {
+    constexpr int Grids = 4;
+    constexpr int EditsPerGrid = 3000;
+    for (int round = 0; round < Grids; ++round) {
+        const std::uint32_t seed = kSeed + round;
+        Grid grid = makeBenchGrid(MapKind::Random, 48 + 16 * round, 40, 0.25, seed, 5);
+        std::mt19937 rng{seed};
+
+        DStarLiteRunner runner(grid);
+        while (!runner.step()) {
+        }
+        for (int edit = 0; edit < EditsPerGrid; ++edit) {
+            const sf::Vector2i cell = randomEdit(grid, rng);
+            runner.gridChanged(cell);
+            while (!runner.step()) {
+            }
+
+            const sf::Vector2i start = *grid.getStart();
+            const sf::Vector2i goal = *grid.getEnd();
+            const std::int64_t expected = referenceCost(grid, start, goal, kFourWay);
+            const std::int64_t cost = runner.getPathCost();
+            const std::int64_t walked = cost < 0 ? -1 : walkedCost(grid, runner.getPath(), start, goal, kFourWay);
+            if (cost != expected || walked != expected) {
+                std::cerr << "FAIL dstar-lite-edits: grid " << round << ", edit " << edit << " at ("
+                          << cell.x << ',' << cell.y << "): cost " << cost << ", path cost " << walked
+                          << ", expected " << expected << "\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool checkFlowFieldEdits() {
+    constexpr int Grids = 3;
+    constexpr int EditsPerGrid = 400;
+    constexpr int Goals = 3;
+    for (int round = 0; round < Grids; ++round) {
+        const std::uint32_t seed = kSeed + round;
+        // več ploščic v obeh smereh, zadnja vrstica in stolpec ploščic nepolna
+        Grid grid = makeBenchGrid(MapKind::Random, 2 * FlowField::TileSize + 17 + 23 * round,
+                                  2 * FlowField::TileSize + 5, 0.25, seed, 5);
+        std::mt19937 rng{seed};
+
+        std::vector<sf::Vector2i> goals;
+        for (int i = 0; i < Goals; ++i)
+            goals.push_back(randomCell(grid, rng));
+
+        FlowField field(grid);
+        FlowField fresh(grid);
+        field.build(goals);
+        for (int edit = 0; edit < EditsPerGrid; ++edit) {
+            const sf::Vector2i cell = randomEdit(grid, rng);
+            field.update({&cell, 1});
+            fresh.build(goals);
+
+            auto fail = [&](sf::Vector2i at, const char* what, long long got, long long expected) {
+                std::cerr << "FAIL flowfield-edits: grid " << round << ", edit " << edit << " at (" << cell.x
+                          << ',' << cell.y << "): " << what << " of (" << at.x << ',' << at.y << ") is "
+                          << got << ", expected " << expected << "\n";
+                return false;
+            };
+            for (int y = 0; y < grid.getRows(); ++y) {
+                for (int x = 0; x < grid.getCols(); ++x) {
+                    if (field.distance(x, y) != fresh.distance(x, y))
+                        return fail({x, y}, "distance", field.distance(x, y), fresh.distance(x, y));
+                    const sf::Vector2i dir = field.direction(x, y);
+                    const sf::Vector2i want = fresh.direction(x, y);
+                    if (dir != want)
+                        return fail({x, y}, "direction", dir.x * 10 + dir.y, want.x * 10 + want.y);
+                }
+            }
+
+            // še neodvisna referenca, da build() sam ni napačen
+            const sf::Vector2i start = *grid.getStart();
+            std::int64_t expected = -1;
+            for (const sf::Vector2i& g : goals) {
+                const std::int64_t c = referenceCost(grid, start, g, kFourWay);
+                if (c >= 0 && (expected < 0 || c < expected))
+                    expected = c;
+            }
+            const int d = field.distance(start.x, start.y);
+            const std::int64_t got = d == FlowField::Unreachable ? -1 : d;
+            if (got != expected)
+                return fail(start, "distance", got, expected);
+        }
+    }
+    return true;
+}
+
+struct CheckEntry {
+    const char* name;
+    bool (*run)();
+};
+
+const CheckEntry kChecks[] = {
+    {"octile-overflow", &checkOctileOverflow},
+    {"dstar-lite-edits", &checkDStarLiteEdits},
+    {"flowfield-edits", &checkFlowFieldEdits},
+};
+
+void printUsage() {
+    std::cerr << "Usage: PathfindingChecks [check...]\n"
+                 "  checks: ";
+    for (std::size_t i = 0; i < std::size(kChecks); ++i)
+        std::cerr << (i ? "," : "") << kChecks[i].name;
+    std::cerr << " (default all)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<const CheckEntry*> selected;
+    for (int i = 1; i < argc; ++i) {
+        const std::string name = argv[i];
+        const CheckEntry* found = nullptr;
+        for (const auto& entry : kChecks)
+            if (name == entry.name)
+                found = &entry;
+        if (!found) {
+            std::cerr << "Unknown check: " << name << "\n";
+            printUsage();
+            return 2;
+        }
+        selected.push_back(found);
+    }
+    if (selected.empty())
+        for (const auto& entry : kChecks)
+            selected.push_back(&entry);
+
+    int failed = 0;
+    for (const CheckEntry* entry : selected) {
+        const bool ok = entry->run();
+        std::cout << (ok ? "ok   " : "FAIL ") << entry->name << "\n";
+        failed += ok ? 0 : 1;
+    }
+    return failed > 0 ? 1 : 0;
+}
@@ -3,54 +3,350 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <tuple>
+#include <variant>
 
 #include "Grid.hpp"
+#include "GridFile.hpp"
+#include "GridRenderer.hpp"
 #include "BFSRunner.hpp"
 #include "DijkstraRunner.hpp"
 #include "AStarRunner.hpp"
+#include "JPSRunner.hpp"
+#include "BidirectionalRunner.hpp"
+#include "FloodFillRunner.hpp"
+#include "DStarLiteRunner.hpp"
+#include "HPAStarRunner.hpp"
+#include "ThreadPool.hpp"
 
 // Način risanja z miško (kaj delamo z levim klikom)
 enum class PaintMode {
     Walls,
     Start,
-    End
+    End,
+    Terrain
 };
 
-// Kateri algoritem je trenutno aktiven v simulaciji
-enum class ActiveAlgo {
-    None,
-    BFS,
-    Dijkstra,
-    AStar
+// Open list za Dijkstra/A* (Q preklaplja po vrsti)
+enum class OpenListKind {
+    Heap,
+    Bucket,
+    Radix
 };
 
-int main() {
+// Sosedstvo za BFS/Dijkstra/A* (O preklaplja po vrsti)
+enum class MoveMode {
+    Four,          // samo pravokotni premiki
+    Eight,         // tudi diagonale, brez rezanja vogalov
+    EightCutCorner // diagonala ob zidu, če je prosta vsaj ena pravokotna celica
+};
+
+// Koliko korakov algoritma naredimo v enem frame-u (N preklaplja način)
+enum class StepMode {
+    Steps,   // stepsPerFrame korakov
+    Budget,  // koraki, dokler ne porabimo frameBudgetMs
+    Instant  // do konca v enem frame-u
+};
+
+// cena terena, ki ga riše PaintMode::Terrain (blato)
+const int terrainPaintCost = 5;
+
+// velikost gruče HPA* na privzeti mreži (40x30 celic da 4x3 gruče);
+// večje mreže uporabijo HierarchicalGraph::DefaultClusterSize
+const int hpaClusterSize = 10;
+
+// Kamera: korak zooma na klik kolesca, najmanjša in največja velikost celice
+// na zaslonu (v pikslih) in premik s puščicami (delež pogleda)
+const float zoomStep = 1.25f;
+const float maxCellPixels = 64.f;
+const float minCellPixels = 1.f / 64.f;
+const float panFraction = 0.25f;
+
+// Runner, ki je trenutno aktiven v simulaciji (po en naenkrat);
+// std::monostate pomeni, da ni aktivnega algoritma
+using ActiveRunner = std::variant<
+    std::monostate,
+    BFSRunner,
+    DijkstraRunner,
+    AStarRunner,
+    DijkstraBucketRunner,
+    AStarBucketRunner,
+    DijkstraRadixRunner,
+    AStarRadixRunner,
+    JPSRunner,
+    JPSPlusRunner,
+    BidirectionalBFSRunner,
+    BidirectionalAStarRunner,
+    FloodFillRunner,
+    DStarLiteRunner,
+    HPAStarRunner,
+    BFS8Runner,
+    Dijkstra8Runner,
+    AStar8Runner
+>;
+
+// Pokliče f(runner) za aktivni runner; vrne false, če ni aktivnega
+template <class Runner, class F>
+bool visitRunner(Runner& active, F&& f) {
+    return std::visit([&](auto& runner) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(runner)>, std::monostate>) {
+            return false;
+        } else {
+            f(runner);
+            return true;
+        }
+    }, active);
+}
+
+void printUsage() {
+    std::cerr <<
+        "Usage: PathfindingSimulator [options] [map]\n"
+        "  map                      grid file (.pfg) or MovingAI .map to load\n"
+        "  --cols N --rows N        grid size without a map (default 40x30)\n";
+}
+
+int main(int argc, char** argv) {
     const int cellSize = 20;
-    const int cols = 40;
-    const int rows = 30;
+    int cols = 40;
+    int rows = 30;
+    std::string mapPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (!key.starts_with("-") && mapPath.empty()) {
+            mapPath = key;
+            continue;
+        }
+        if (key == "--help" || key == "-h" || i + 1 >= argc) {
+            printUsage();
+            return key == "--help" || key == "-h" ? 0 : 1;
+        }
+        const std::string value = argv[++i];
+        if (key == "--cols") {
+            cols = std::atoi(value.c_str());
+        } else if (key == "--rows") {
+            rows = std::atoi(value.c_str());
+        } else {
+            std::cerr << "Unknown option: " << key << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+    if (cols <= 0 || rows <= 0) {
+        std::cerr << "cols and rows must be positive\n";
+        return 1;
+    }
 
-    // Dimenzije mreže in HUD-a
-    const int gridWidth  = cols * cellSize;
-    const int gridHeight = rows * cellSize;
+    // Dimenzije okna: levo pogled na mrežo, desno HUD. Privzeta mreža 40x30
+    // ravno zapolni pogled; večje se gledajo s kamero (pan/zoom).
+    const int viewWidth  = 800;
+    const int viewHeight = 600;
     const int hudWidth   = 400;
-    const int windowWidth  = gridWidth + hudWidth;
-    const int windowHeight = gridHeight;
+    const int windowWidth  = viewWidth + hudWidth;
+    const int windowHeight = viewHeight;
+
+    std::optional<Grid> loaded;
+    if (!mapPath.empty()) {
+        std::string error;
+        loaded = loadGrid(mapPath, cellSize, &error);
+        if (!loaded) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+    }
+    Grid grid = loaded ? std::move(*loaded) : Grid(cols, rows, cellSize);
+    loaded.reset();
+    cols = grid.getCols();
+    rows = grid.getRows();
 
-    Grid grid(cols, rows, cellSize);
-    PaintMode mode = PaintMode::Walls;
+    // K shrani mrežo: nazaj v naloženo binarno datoteko, sicer v grid.pfg
+    const std::string savePath = mapPath.ends_with(".pfg") ? mapPath : "grid.pfg";
 
-    // Runnerji za posamezne algoritme (po en naenkrat)
-    std::optional<BFSRunner>       bfsRunner;
-    std::optional<DijkstraRunner>  dijkstraRunner;
-    std::optional<AStarRunner>     aStarRunner;
+    PaintMode mode = PaintMode::Walls;
 
-    ActiveAlgo activeAlgo = ActiveAlgo::None;
+    // vidni kosi mreže v vertex arrayih; prebarvajo se samo spremenjene celice
+    GridRenderer renderer(grid);
+
+    // Kamera nad mrežo (svetovne koordinate = celice * cellSize). Kolesce
+    // zooma okoli kurzorja, srednji gumb ali puščice premikajo, Home pokaže
+    // celo mrežo.
+    sf::View gridView;
+    gridView.setViewport(sf::FloatRect({0.f, 0.f},
+        {static_cast<float>(viewWidth) / static_cast<float>(windowWidth), 1.f}));
+    const float worldWidth  = static_cast<float>(cols) * static_cast<float>(cellSize);
+    const float worldHeight = static_cast<float>(rows) * static_cast<float>(cellSize);
+
+    auto fitView = [&]() {
+        const float scale = std::max(worldWidth / viewWidth, worldHeight / viewHeight);
+        gridView.setSize({viewWidth * scale, viewHeight * scale});
+        gridView.setCenter({worldWidth / 2.f, worldHeight / 2.f});
+    };
+    fitView();
+
+    // svetovne enote na piksel zaslona
+    auto viewScale = [&]() { return gridView.getSize().x / viewWidth; };
+
+    // središče pogleda ostane nad mrežo
+    auto clampView = [&]() {
+        const sf::Vector2f c = gridView.getCenter();
+        gridView.setCenter({std::clamp(c.x, 0.f, worldWidth), std::clamp(c.y, 0.f, worldHeight)});
+    };
+
+    // dragPixel je zadnji položaj miške med vlečenjem s srednjim gumbom
+    std::optional<sf::Vector2i> dragPixel;
+
+    // Trenutno aktiven algoritem
+    ActiveRunner runner;
     std::string lastAlgoName = "None";
 
-    // Čas izvajanja trenutnega algoritma
+    // Q preklaplja open list za Dijkstra/A*: kopica, bucket queue ali radix heap
+    OpenListKind openList = OpenListKind::Heap;
+
+    // I preklaplja dvosmerni BFS/A* (iskanje hkrati od starta in od cilja)
+    bool bidirectional = false;
+
+    // O preklaplja 4- / 8-sosedstvo za B, D in A; 8-sosedski runnerji imajo
+    // samo kopico in niso dvosmerni
+    MoveMode moveMode = MoveMode::Four;
+    auto cornerRule = [&]() {
+        return moveMode == MoveMode::EightCutCorner ? CornerCutting::OneSide : CornerCutting::Never;
+    };
+    auto movesSuffix = [&]() {
+        return std::string(moveMode == MoveMode::Eight ? " (8-way)" : " (8-way, cut corners)");
+    };
+
+    // Graf gruč za HPA*; zgradi se ob prvi uporabi, nato se ob urejanju mreže
+    // popravijo samo spremenjene gruče. G preklaplja risanje grafa.
+    std::shared_ptr<HierarchicalGraph> hpaGraph;
+    bool showClusters = false;
+    auto ensureHpaGraph = [&]() {
+        if (!hpaGraph) {
+            const bool small = cols <= 4 * hpaClusterSize && rows <= 4 * hpaClusterSize;
+            hpaGraph = std::make_shared<HierarchicalGraph>(
+                grid, small ? hpaClusterSize : HierarchicalGraph::DefaultClusterSize);
+        }
+        return hpaGraph;
+    };
+
+    // M na veliki mreži generira labirint po ploščicah na vseh jedrih; bazen
+    // niti se ustvari ob prvi uporabi
+    constexpr long long tiledMazeCells = 1LL << 20;
+    std::unique_ptr<ThreadPool> mazePool;
+
+    // Koraki na frame; +/- podvoji ali razpolovi število korakov oz. budget
+    StepMode stepMode = StepMode::Steps;
+    int stepsPerFrame = 1;
+    double frameBudgetMs = 2.0;
+
+    // Čas izvajanja trenutnega algoritma: wall od zagona (z risanjem vred)
+    // in CPU čas, ki ga meri samo zanka klicev step()
     sf::Clock algoClock;
     bool timing = false;
     float elapsedMs = 0.0f;
+    double algoCpuMs = 0.0;
+
+    using StepClock = std::chrono::steady_clock;
+    auto msSince = [](StepClock::time_point t0) {
+        return std::chrono::duration<double, std::milli>(StepClock::now() - t0).count();
+    };
+
+    // koraki tega frame-a po izbranem načinu; vrne true, ko je algoritem končan
+    auto runSteps = [&](auto& algo) {
+        const auto t0 = StepClock::now();
+        bool done = false;
+        switch (stepMode) {
+            case StepMode::Steps:
+                for (int i = 0; i < stepsPerFrame && !done; ++i)
+                    done = algo.step();
+                break;
+            case StepMode::Budget:
+                // uro beremo le vsakih nekaj korakov, da meritev ne poje budgeta
+                do {
+                    for (int i = 0; i < 64 && !done; ++i)
+                        done = algo.step();
+                } while (!done && msSince(t0) < frameBudgetMs);
+                break;
+            case StepMode::Instant:
+                while (!done)
+                    done = algo.step();
+                break;
+        }
+        algoCpuMs += msSince(t0);
+        return done;
+    };
+
+    // zažene nov runner tipa tag::type, če sta start in end nastavljena;
+    // args se podajo konstruktorju za mrežo
+    auto startAlgo = [&](auto tag, const std::string& name, auto&&... args) {
+        using Runner = typename decltype(tag)::type;
+        renderer.invalidate();
+        if (grid.hasStart() && grid.hasEnd()) {
+            runner.emplace<Runner>(grid, args...).setChangeLog(&renderer.runnerChanges());
+            lastAlgoName = name;
+
+            algoClock.restart();
+            timing = true;
+            elapsedMs = 0.0f;
+            algoCpuMs = 0.0;
+        } else {
+            runner.emplace<std::monostate>();
+            timing = false;
+            lastAlgoName = "None";
+        }
+    };
+
+    // ustavi aktivni algoritem (mreža ostane)
+    auto stopAlgo = [&]() {
+        renderer.invalidate();
+        runner.emplace<std::monostate>();
+        timing = false;
+    };
+
+    // Urejanje celice cell. Inkrementalni runner (D* Lite) sprememba popravi,
+    // vse ostale ustavi. Končano iskanje popravimo takoj, da je prikazana pot
+    // med risanjem ves čas veljavna.
+    auto gridEdited = [&](sf::Vector2i cell, bool changed) {
+        if (changed && hpaGraph)
+            hpaGraph->update({&cell, 1});
+
+        bool kept = false;
+        visitRunner(runner, [&](auto& algo) {
+            if constexpr (requires { algo.gridChanged(cell); }) {
+                kept = true;
+                if (!changed)
+                    return;
+                // CPU čas šteje samo popravek (kot getVisitedCount())
+                const bool wasFinished = algo.isFinished();
+                const auto t0 = StepClock::now();
+                algoCpuMs = 0.0;
+                algo.gridChanged(cell);
+                if (wasFinished) {
+                    while (!algo.step()) {
+                    }
+                }
+                algoCpuMs += msSince(t0);
+            }
+        });
+        if (!kept)
+            stopAlgo();
+    };
+
+    // stanje celice, da ločimo pravo spremembo od držanja miške na isti celici
+    auto cellState = [&](int gx, int gy) {
+        return std::make_tuple(grid.isWall(gx, gy), grid.getCost(gx, gy),
+                               grid.isStart(gx, gy), grid.isEnd(gx, gy),
+                               grid.getStart(), grid.getEnd());
+    };
 
     sf::RenderWindow window(
         sf::VideoMode({static_cast<unsigned int>(windowWidth),
@@ -78,6 +374,37 @@ int main() {
             if (event->is<sf::Event::Closed>())
                 window.close();
 
+            // KAMERA: zoom okoli kurzorja (točka pod miško ostane na mestu)
+            if (const auto* wheel = event->getIf<sf::Event::MouseWheelScrolled>()) {
+                if (wheel->wheel == sf::Mouse::Wheel::Vertical && wheel->position.x < viewWidth) {
+                    const float factor = wheel->delta > 0.f ? 1.f / zoomStep : zoomStep;
+                    const float scale = std::clamp(viewScale() * factor,
+                                                   cellSize / maxCellPixels, cellSize / minCellPixels);
+                    const sf::Vector2f before = window.mapPixelToCoords(wheel->position, gridView);
+                    gridView.zoom(scale / viewScale());
+                    const sf::Vector2f after = window.mapPixelToCoords(wheel->position, gridView);
+                    gridView.move(before - after);
+                    clampView();
+                }
+            }
+
+            if (const auto* pressed = event->getIf<sf::Event::MouseButtonPressed>()) {
+                if (pressed->button == sf::Mouse::Button::Middle)
+                    dragPixel = pressed->position;
+            }
+            if (const auto* released = event->getIf<sf::Event::MouseButtonReleased>()) {
+                if (released->button == sf::Mouse::Button::Middle)
+                    dragPixel.reset();
+            }
+            if (const auto* moved = event->getIf<sf::Event::MouseMoved>()) {
+                if (dragPixel) {
+                    gridView.move(window.mapPixelToCoords(*dragPixel, gridView) -
+                                  window.mapPixelToCoords(moved->position, gridView));
+                    clampView();
+                    dragPixel = moved->position;
+                }
+            }
+
             if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
                 switch (keyPressed->code) {
                     case sf::Keyboard::Key::W:
@@ -89,84 +416,179 @@ int main() {
                     case sf::Keyboard::Key::E:
                         mode = PaintMode::End;
                         break;
+                    case sf::Keyboard::Key::T:
+                        mode = PaintMode::Terrain;
+                        break;
 
                     // BFS
-                    case sf::Keyboard::Key::B: {
-                        if (grid.hasStart() && grid.hasEnd()) {
-                            bfsRunner.emplace(grid);
-                            dijkstraRunner.reset();
-                            aStarRunner.reset();
-                            activeAlgo = ActiveAlgo::BFS;
-                            lastAlgoName = "BFS";
-
-                            algoClock.restart();
-                            timing = true;
-                            elapsedMs = 0.0f;
-                        } else {
-                            bfsRunner.reset();
-                            dijkstraRunner.reset();
-                            aStarRunner.reset();
-                            activeAlgo = ActiveAlgo::None;
-                            timing = false;
-                            lastAlgoName = "None";
-                        }
+                    case sf::Keyboard::Key::B:
+                        if (moveMode != MoveMode::Four)
+                            startAlgo(std::type_identity<BFS8Runner>{}, "BFS" + movesSuffix(), cornerRule());
+                        else if (bidirectional)
+                            startAlgo(std::type_identity<BidirectionalBFSRunner>{}, "BFS (bidirectional)");
+                        else
+                            startAlgo(std::type_identity<BFSRunner>{}, "BFS");
                         break;
-                    }
 
                     // Dijkstra
-                    case sf::Keyboard::Key::D: {
-                        if (grid.hasStart() && grid.hasEnd()) {
-                            dijkstraRunner.emplace(grid);
-                            bfsRunner.reset();
-                            aStarRunner.reset();
-                            activeAlgo = ActiveAlgo::Dijkstra;
-                            lastAlgoName = "Dijkstra";
-
-                            algoClock.restart();
-                            timing = true;
-                            elapsedMs = 0.0f;
-                        } else {
-                            bfsRunner.reset();
-                            dijkstraRunner.reset();
-                            aStarRunner.reset();
-                            activeAlgo = ActiveAlgo::None;
-                            timing = false;
-                            lastAlgoName = "None";
+                    case sf::Keyboard::Key::D:
+                        if (moveMode != MoveMode::Four) {
+                            startAlgo(std::type_identity<Dijkstra8Runner>{}, "Dijkstra" + movesSuffix(), cornerRule());
+                            break;
+                        }
+                        switch (openList) {
+                            case OpenListKind::Heap:
+                                startAlgo(std::type_identity<DijkstraRunner>{}, "Dijkstra");
+                                break;
+                            case OpenListKind::Bucket:
+                                startAlgo(std::type_identity<DijkstraBucketRunner>{}, "Dijkstra (bucket)");
+                                break;
+                            case OpenListKind::Radix:
+                                startAlgo(std::type_identity<DijkstraRadixRunner>{}, "Dijkstra (radix)");
+                                break;
                         }
                         break;
-                    }
 
                     // A*
-                    case sf::Keyboard::Key::A: {
-                        if (grid.hasStart() && grid.hasEnd()) {
-                            aStarRunner.emplace(grid);
-                            bfsRunner.reset();
-                            dijkstraRunner.reset();
-                            activeAlgo = ActiveAlgo::AStar;
-                            lastAlgoName = "A*";
-
-                            algoClock.restart();
-                            timing = true;
-                            elapsedMs = 0.0f;
-                        } else {
-                            bfsRunner.reset();
-                            dijkstraRunner.reset();
-                            aStarRunner.reset();
-                            activeAlgo = ActiveAlgo::None;
-                            timing = false;
-                            lastAlgoName = "None";
+                    case sf::Keyboard::Key::A:
+                        if (moveMode != MoveMode::Four) {
+                            startAlgo(std::type_identity<AStar8Runner>{}, "A*" + movesSuffix(), cornerRule());
+                            break;
+                        }
+                        if (bidirectional) {
+                            startAlgo(std::type_identity<BidirectionalAStarRunner>{}, "A* (bidirectional)");
+                            break;
+                        }
+                        switch (openList) {
+                            case OpenListKind::Heap:
+                                startAlgo(std::type_identity<AStarRunner>{}, "A*");
+                                break;
+                            case OpenListKind::Bucket:
+                                startAlgo(std::type_identity<AStarBucketRunner>{}, "A* (bucket)");
+                                break;
+                            case OpenListKind::Radix:
+                                startAlgo(std::type_identity<AStarRadixRunner>{}, "A* (radix)");
+                                break;
+                        }
+                        break;
+
+                    // O = 4-sosedstvo -> 8 brez rezanja vogalov -> 8 z rezanjem vogalov
+                    case sf::Keyboard::Key::O:
+                        switch (moveMode) {
+                            case MoveMode::Four:           moveMode = MoveMode::Eight;          break;
+                            case MoveMode::Eight:          moveMode = MoveMode::EightCutCorner; break;
+                            case MoveMode::EightCutCorner: moveMode = MoveMode::Four;           break;
+                        }
+                        break;
+
+                    // BFS po bitsetu (en korak = cel sloj)
+                    case sf::Keyboard::Key::F:
+                        startAlgo(std::type_identity<FloodFillRunner>{}, "BFS (bit flood fill)");
+                        break;
+
+                    // JPS / JPS+ (vsi koraki stanejo 1, teren se ignorira)
+                    case sf::Keyboard::Key::J:
+                        startAlgo(std::type_identity<JPSRunner>{}, "JPS");
+                        break;
+                    case sf::Keyboard::Key::P:
+                        startAlgo(std::type_identity<JPSPlusRunner>{}, "JPS+");
+                        break;
+
+                    // D* Lite (ob risanju popravi pot, namesto da bi se ustavil)
+                    case sf::Keyboard::Key::L:
+                        startAlgo(std::type_identity<DStarLiteRunner>{}, "D* Lite");
+                        break;
+
+                    // H = HPA* (iskanje po grafu gruč, nato po celicah)
+                    case sf::Keyboard::Key::H:
+                        startAlgo(std::type_identity<HPAStarRunner>{}, "HPA*",
+                                  std::shared_ptr<const HierarchicalGraph>(ensureHpaGraph()));
+                        break;
+
+                    // G = prikaz grafa gruč HPA* (meje gruč, vhodi, povezave)
+                    case sf::Keyboard::Key::G:
+                        showClusters = !showClusters;
+                        if (showClusters)
+                            ensureHpaGraph();
+                        break;
+
+                    // Q = preklop open lista (kopica -> bucket queue -> radix heap) za Dijkstra in A*
+                    case sf::Keyboard::Key::Q:
+                        switch (openList) {
+                            case OpenListKind::Heap:   openList = OpenListKind::Bucket; break;
+                            case OpenListKind::Bucket: openList = OpenListKind::Radix;  break;
+                            case OpenListKind::Radix:  openList = OpenListKind::Heap;   break;
                         }
                         break;
+
+                    // N = način korakov: N na frame -> časovni budget na frame -> takoj do konca
+                    case sf::Keyboard::Key::N:
+                        switch (stepMode) {
+                            case StepMode::Steps:   stepMode = StepMode::Budget;  break;
+                            case StepMode::Budget:  stepMode = StepMode::Instant; break;
+                            case StepMode::Instant: stepMode = StepMode::Steps;   break;
+                        }
+                        break;
+
+                    // + / - = več / manj korakov (ali časa) na frame
+                    case sf::Keyboard::Key::Equal:
+                    case sf::Keyboard::Key::Add:
+                        if (stepMode == StepMode::Budget)
+                            frameBudgetMs = std::min(frameBudgetMs * 2.0, 64.0);
+                        else
+                            stepsPerFrame = std::min(stepsPerFrame * 2, 1 << 20);
+                        break;
+
+                    case sf::Keyboard::Key::Hyphen:
+                    case sf::Keyboard::Key::Subtract:
+                        if (stepMode == StepMode::Budget)
+                            frameBudgetMs = std::max(frameBudgetMs / 2.0, 0.125);
+                        else
+                            stepsPerFrame = std::max(stepsPerFrame / 2, 1);
+                        break;
+
+                    // puščice = premik kamere, Home = cela mreža
+                    case sf::Keyboard::Key::Left:
+                        gridView.move({-gridView.getSize().x * panFraction, 0.f});
+                        clampView();
+                        break;
+                    case sf::Keyboard::Key::Right:
+                        gridView.move({gridView.getSize().x * panFraction, 0.f});
+                        clampView();
+                        break;
+                    case sf::Keyboard::Key::Up:
+                        gridView.move({0.f, -gridView.getSize().y * panFraction});
+                        clampView();
+                        break;
+                    case sf::Keyboard::Key::Down:
+                        gridView.move({0.f, gridView.getSize().y * panFraction});
+                        clampView();
+                        break;
+                    case sf::Keyboard::Key::Home:
+                        fitView();
+                        break;
+
+                    // K = shrani mrežo (zidovi, teren, start/end)
+                    case sf::Keyboard::Key::K: {
+                        std::string error;
+                        if (saveGridFile(grid, savePath, &error))
+                            std::cout << "Saved grid to " << savePath << "\n";
+                        else
+                            std::cerr << error << "\n";
+                        break;
                     }
 
+                    // I = preklop dvosmernega iskanja za BFS in A*
+                    case sf::Keyboard::Key::I:
+                        bidirectional = !bidirectional;
+                        break;
+
                     // C = popoln reset (mreža + start/end + algoritmi + čas)
                     case sf::Keyboard::Key::C: {
                         grid.clearAll();
-                        bfsRunner.reset();
-                        dijkstraRunner.reset();
-                        aStarRunner.reset();
-                        activeAlgo = ActiveAlgo::None;
-                        timing = false;
+                        stopAlgo();
+                        if (hpaGraph)
+                            hpaGraph->rebuild();
                         elapsedMs = 0.0f;
                         lastAlgoName = "None";
                         break;
@@ -174,11 +596,7 @@ int main() {
 
                     // R = reset samo algoritmov (mreža ostane)
                     case sf::Keyboard::Key::R: {
-                        bfsRunner.reset();
-                        dijkstraRunner.reset();
-                        aStarRunner.reset();
-                        activeAlgo = ActiveAlgo::None;
-                        timing = false;
+                        stopAlgo();
                         elapsedMs = 0.0f;
                         lastAlgoName = "None";
                         break;
@@ -186,12 +604,17 @@ int main() {
 
                     // M = generiraj nov random labirint
                     case sf::Keyboard::Key::M: {
-                        grid.generateMaze();
-                        bfsRunner.reset();
-                        dijkstraRunner.reset();
-                        aStarRunner.reset();
-                        activeAlgo = ActiveAlgo::None;
-                        timing = false;
+                        if (static_cast<long long>(cols) * rows >= tiledMazeCells) {
+                            if (!mazePool)
+                                mazePool = std::make_unique<ThreadPool>();
+                            grid.generateMaze(std::random_device{}(), MazeAlgorithm::Backtracker,
+                                              *mazePool);
+                        } else {
+                            grid.generateMaze();
+                        }
+                        stopAlgo();
+                        if (hpaGraph)
+                            hpaGraph->rebuild();
                         elapsedMs = 0.0f;
                         lastAlgoName = "None";
                         break;
@@ -203,12 +626,17 @@ int main() {
             }
         }
 
-        // REAL-TIME MIŠ (risanje po mreži)
+        // REAL-TIME MIŠ (risanje po mreži); piksel gre skozi pogled kamere
         sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-        if (auto cell = grid.worldToCell(mousePos)) {
+        std::optional<sf::Vector2i> cell;
+        if (mousePos.x >= 0 && mousePos.x < viewWidth && mousePos.y >= 0 && mousePos.y < viewHeight)
+            cell = grid.worldToCell(window.mapPixelToCoords(mousePos, gridView));
+        if (cell) {
             int gx = cell->x;
             int gy = cell->y;
 
+            const auto before = cellState(gx, gy);
+
             if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left)) {
                 switch (mode) {
                     case PaintMode::Walls:
@@ -220,92 +648,86 @@ int main() {
                     case PaintMode::End:
                         grid.setEnd(gx, gy);
                         break;
+                    case PaintMode::Terrain:
+                        grid.setWall(gx, gy, false);
+                        grid.setCost(gx, gy, terrainPaintCost);
+                        break;
                 }
-                // vsaka sprememba mreže invalidira prejšnji algoritem
-                bfsRunner.reset();
-                dijkstraRunner.reset();
-                aStarRunner.reset();
-                activeAlgo = ActiveAlgo::None;
-                timing = false;
+                // vsaka sprememba mreže invalidira prejšnji algoritem (razen D* Lite)
+                gridEdited(*cell, cellState(gx, gy) != before);
             } else if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Right)) {
                 grid.clearCell(gx, gy);
-                bfsRunner.reset();
-                dijkstraRunner.reset();
-                aStarRunner.reset();
-                activeAlgo = ActiveAlgo::None;
-                timing = false;
+                gridEdited(*cell, cellState(gx, gy) != before);
             }
         }
 
-        // KORAKI ALGORITMOV (en ali več stepov na frame)
-        if (activeAlgo == ActiveAlgo::BFS && bfsRunner && !bfsRunner->isFinished()) {
-            bfsRunner->step();
-            if (bfsRunner->isFinished()) {
-                elapsedMs = algoClock.getElapsedTime().asMilliseconds();
-                timing = false;
-            }
-        } else if (activeAlgo == ActiveAlgo::Dijkstra && dijkstraRunner && !dijkstraRunner->isFinished()) {
-            dijkstraRunner->step();
-            if (dijkstraRunner->isFinished()) {
+        // KORAKI ALGORITMOV (število na frame določa stepMode)
+        visitRunner(runner, [&](auto& algo) {
+            if (algo.isFinished())
+                return;
+            if (runSteps(algo)) {
                 elapsedMs = algoClock.getElapsedTime().asMilliseconds();
                 timing = false;
             }
-        } else if (activeAlgo == ActiveAlgo::AStar && aStarRunner && !aStarRunner->isFinished()) {
-            aStarRunner->step();
-            if (aStarRunner->isFinished()) {
-                elapsedMs = algoClock.getElapsedTime().asMilliseconds();
-                timing = false;
-            }
-        }
+        });
 
         // RISANJE
         window.clear(sf::Color::Black);
 
-        sf::RectangleShape cellShape({19.f, 19.f});
-
-        // MREŽA (celice + obarvani seti)
-        for (int y = 0; y < grid.getRows(); ++y) {
-            for (int x = 0; x < grid.getCols(); ++x) {
-
-                bool inPath   = false;
-                bool inOpen   = false;
-                bool inClosed = false;
-
-                if (activeAlgo == ActiveAlgo::BFS && bfsRunner) {
-                    inPath   = bfsRunner->isInPath(x, y);
-                    inOpen   = bfsRunner->isOpen(x, y);
-                    inClosed = bfsRunner->isClosed(x, y);
-                } else if (activeAlgo == ActiveAlgo::Dijkstra && dijkstraRunner) {
-                    inPath   = dijkstraRunner->isInPath(x, y);
-                    inOpen   = dijkstraRunner->isOpen(x, y);
-                    inClosed = dijkstraRunner->isClosed(x, y);
-                } else if (activeAlgo == ActiveAlgo::AStar && aStarRunner) {
-                    inPath   = aStarRunner->isInPath(x, y);
-                    inOpen   = aStarRunner->isOpen(x, y);
-                    inClosed = aStarRunner->isClosed(x, y);
-                }
-
-                if (grid.isStart(x, y)) {
-                    cellShape.setFillColor(sf::Color::Green);
-                } else if (grid.isEnd(x, y)) {
-                    cellShape.setFillColor(sf::Color::Red);
-                } else if (inPath) {
-                    cellShape.setFillColor(sf::Color(128, 0, 128));
-                } else if (inClosed) {
-                    cellShape.setFillColor(sf::Color::Yellow);
-                } else if (inOpen) {
-                    cellShape.setFillColor(sf::Color::Blue);
-                } else if (grid.isWall(x, y)) {
-                    cellShape.setFillColor(sf::Color(100, 100, 100));
-                } else {
-                    cellShape.setFillColor(sf::Color(50, 50, 50));
-                }
-
-                cellShape.setPosition(grid.cellToWorld(x, y));
-                window.draw(cellShape);
+        // MREŽA: v pogledu kamere narišemo samo vidne kose (prebarvajo se
+        // spremenjene celice)
+        window.setView(gridView);
+        if (!visitRunner(runner, [&](const auto& algo) { renderer.draw(window, &algo); }))
+            renderer.draw(window, static_cast<const BFSRunner*>(nullptr));
+
+        // GRAF GRUČ (HPA*): meje gruč, povezave znotraj gruč, vozlišča vhodov;
+        // samo za vidne gruče in ne, ko je celica na zaslonu premajhna
+        if (showClusters && hpaGraph && renderer.level() == 0) {
+            const float cs = static_cast<float>(cellSize);
+            const float span = static_cast<float>(hpaGraph->clusterSize()) * cs;
+            auto center = [&](sf::Vector2i p) {
+                return grid.cellToWorld(p.x, p.y) + sf::Vector2f{cs / 2.f, cs / 2.f};
+            };
+
+            const sf::Vector2f half = gridView.getSize() / 2.f;
+            const sf::Vector2f viewMin = gridView.getCenter() - half;
+            const sf::Vector2f viewMax = gridView.getCenter() + half;
+            const sf::Vector2i cellMin{std::max(0, static_cast<int>(viewMin.x / cs)),
+                                       std::max(0, static_cast<int>(viewMin.y / cs))};
+            const sf::Vector2i cellMax{static_cast<int>(viewMax.x / cs),
+                                       static_cast<int>(viewMax.y / cs)};
+            const float top = std::max(0.f, viewMin.y), bottom = std::min(worldHeight, viewMax.y);
+            const float left = std::max(0.f, viewMin.x), right = std::min(worldWidth, viewMax.x);
+
+            sf::VertexArray lines(sf::PrimitiveType::Lines);
+            const sf::Color borderColor(255, 255, 255, 90);
+            for (float x = std::ceil(left / span) * span; x < right; x += span) {
+                lines.append({{x, top}, borderColor});
+                lines.append({{x, bottom}, borderColor});
             }
+            for (float y = std::ceil(top / span) * span; y < bottom; y += span) {
+                lines.append({{left, y}, borderColor});
+                lines.append({{right, y}, borderColor});
+            }
+
+            const sf::Color edgeColor(0, 200, 200, 120);
+            hpaGraph->forEachIntraEdge([&](sf::Vector2i a, sf::Vector2i b) {
+                lines.append({center(a), edgeColor});
+                lines.append({center(b), edgeColor});
+            }, cellMin, cellMax);
+            window.draw(lines);
+
+            sf::RectangleShape nodeShape({cs / 2.f, cs / 2.f});
+            nodeShape.setFillColor(sf::Color(0, 255, 255));
+            hpaGraph->forEachNode([&](sf::Vector2i p) {
+                nodeShape.setPosition(center(p) - sf::Vector2f{cs / 4.f, cs / 4.f});
+                window.draw(nodeShape);
+            }, cellMin, cellMax);
         }
 
+        // HUD je v privzetem pogledu okna
+        window.setView(window.getDefaultView());
+
         // HUD ozadje na desni strani
         sf::RectangleShape hudBackground(sf::Vector2f{
             static_cast<float>(hudWidth),
@@ -313,67 +735,106 @@ int main() {
         });
         hudBackground.setFillColor(sf::Color(0, 0, 0, 220));
         hudBackground.setPosition(sf::Vector2f{
-            static_cast<float>(gridWidth), 0.f
+            static_cast<float>(viewWidth), 0.f
         });
         window.draw(hudBackground);
 
         // HUD: čas + statistika + kontrole
         if (fontLoaded) {
             sf::Text timerText(font);
-            timerText.setCharacterSize(22);
+            timerText.setCharacterSize(18);
             timerText.setFillColor(sf::Color::White);
 
             float msShown = timing ? algoClock.getElapsedTime().asMilliseconds()
                                    : elapsedMs;
 
-            std::string algoLabel = lastAlgoName;
-            if (activeAlgo == ActiveAlgo::None && lastAlgoName == "None") {
-                algoLabel = "None";
+            std::ostringstream cpuText;
+            cpuText << std::fixed << std::setprecision(3) << algoCpuMs;
+
+            std::ostringstream stepText;
+            switch (stepMode) {
+                case StepMode::Steps:
+                    stepText << stepsPerFrame << (stepsPerFrame == 1 ? " step" : " steps") << " / frame";
+                    break;
+                case StepMode::Budget:
+                    stepText << std::fixed << std::setprecision(2) << frameBudgetMs << " ms / frame";
+                    break;
+                case StepMode::Instant:
+                    stepText << "instant";
+                    break;
             }
 
+            std::string algoLabel = lastAlgoName;
+
             int nodesVisited = 0;
             int pathLength   = 0;
+            long long pathCost = 0;
             int openMaxSize  = 0;
 
-            if (activeAlgo == ActiveAlgo::BFS && bfsRunner) {
-                nodesVisited = bfsRunner->getVisitedCount();
-                pathLength   = bfsRunner->getPathLength();
-                openMaxSize  = bfsRunner->getOpenMaxSize();
-            } else if (activeAlgo == ActiveAlgo::Dijkstra && dijkstraRunner) {
-                nodesVisited = dijkstraRunner->getVisitedCount();
-                pathLength   = dijkstraRunner->getPathLength();
-                openMaxSize  = dijkstraRunner->getOpenMaxSize();
-            } else if (activeAlgo == ActiveAlgo::AStar && aStarRunner) {
-                nodesVisited = aStarRunner->getVisitedCount();
-                pathLength   = aStarRunner->getPathLength();
-                openMaxSize  = aStarRunner->getOpenMaxSize();
-            }
+            visitRunner(runner, [&](const auto& algo) {
+                nodesVisited = algo.getVisitedCount();
+                pathLength   = algo.getPathLength();
+                pathCost     = std::max<long long>(0, algo.getPathCost());
+                openMaxSize  = algo.getOpenMaxSize();
+            });
+
+            std::ostringstream viewText;
+            viewText << cols << "x" << rows << ", 1:" << (1 << renderer.level())
+                     << ", " << renderer.chunksDrawn() << " chunks";
+
+            const char* movesName =
+                moveMode == MoveMode::Four  ? "4-way" :
+                moveMode == MoveMode::Eight ? "8-way (cost x10)" : "8-way, cut corners (cost x10)";
+
+            const char* openListName =
+                openList == OpenListKind::Heap   ? "heap" :
+                openList == OpenListKind::Bucket ? "bucket" : "radix";
 
             timerText.setString(
                 "Algo: " + algoLabel + "\n" +
-                "Time: " + std::to_string(static_cast<int>(msShown)) + " ms\n" +
+                "Wall time:     " + std::to_string(static_cast<int>(msShown)) + " ms\n" +
+                "Algo CPU time: " + cpuText.str() + " ms\n" +
+                "Stepping:      " + stepText.str() + "\n" +
                 "Nodes visited: " + std::to_string(nodesVisited) + "\n" +
                 "Path length:   " + std::to_string(pathLength) + "\n" +
-                "Max open size: " + std::to_string(openMaxSize) + "\n\n" +
+                "Path cost:     " + std::to_string(pathCost) + "\n" +
+                "Max open size: " + std::to_string(openMaxSize) + "\n" +
+                "Open list:     " + openListName + "\n" +
+                "Bidirectional: " + (bidirectional ? "on" : "off") + "\n" +
+                "Moves:         " + movesName + "\n" +
+                "View:          " + viewText.str() + "\n\n" +
                 "Controls:\n"
                 "  B = Run BFS\n"
+                "  F = Run bit flood-fill BFS\n"
                 "  D = Run Dijkstra\n"
                 "  A = Run A*\n"
+                "  J / P = Run JPS / JPS+\n"
+                "  L = Run D* Lite (replans on edits)\n"
+                "  H = Run HPA* (G = show clusters)\n"
+                "  Q = Heap / bucket / radix\n"
+                "  I = Bidirectional BFS / A*\n"
+                "  O = 4 / 8-way / 8-way cut corners\n"
+                "  N = Steps / budget / instant\n"
+                "  + / - = More / less per frame\n"
                 "\n"
                 "  R = Reset algorithms\n"
                 "  C = Clear ALL\n"
                 "  M = Random maze\n"
+                "  K = Save grid (" + savePath + ")\n"
                 "\n"
                 "  W = Set Walls\n"
                 "  S = Set Start\n"
                 "  E = Set End\n"
+                "  T = Paint terrain (cost " + std::to_string(terrainPaintCost) + ")\n"
                 "\n"
                 "Left Click  = paint\n"
                 "Right Click = erase\n"
+                "Wheel / Middle drag / Arrows = zoom / pan\n"
+                "Home = Whole grid\n"
             );
 
             timerText.setPosition(sf::Vector2f{
-                static_cast<float>(gridWidth) + 20.f,
+                static_cast<float>(viewWidth) + 20.f,
                 10.f
             });
             window.draw(timerText);
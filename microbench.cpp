@@ -0,0 +1,352 @@
+// Microbenchmarki posameznih faz (Google Benchmark):
+//   construct/<algo>/<map>/<size>  konstruktor runnerja (alokacije stanja)
+//   step/<algo>/<map>/<size>       vsi klici step() do konca iskanja
+//   buildPath/<algo>/<map>/<size>  samo rekonstrukcija poti
+//   generateMaze/<size>            Grid::generateMaze() (backtracker)
+//   generateMaze/<gen>/<size>      Grid::generateMaze() z eller, kruskal ali wilson
+//   generateMazeTiled/<gen>/<size> Grid::generateMaze() po ploščicah na vseh nitih
+//   flowField/<map>/<size>         FlowField::build() do cilja mreže
+//   flowFieldUpdate/<map>/<size>   FlowField::update() po preklopu enega zidu
+//   replan/dstar-lite/<map>/<size> D* Lite popravek po preklopu zidu na poti
+//   batch/<algo>/<map>/<size>      BatchPathfinder::run() za kBatchQueries naključnih poizvedb
+//   pathCache/hit/<map>/<size>     PathCache::find() za že shranjeno poizvedbo
+//
+// Imena so stabilna, zato se da JSON izhod dveh buildov primerjati direktno:
+//   PathfindingMicrobench --benchmark_format=json > before.json
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "Grid.hpp"
+#include "BenchMaps.hpp"
+#include "BFSRunner.hpp"
+#include "DijkstraRunner.hpp"
+#include "AStarRunner.hpp"
+#include "JPSRunner.hpp"
+#include "BidirectionalRunner.hpp"
+#include "FloodFillRunner.hpp"
+#include "DStarLiteRunner.hpp"
+#include "HPAStarRunner.hpp"
+#include "FlowField.hpp"
+#include "BatchPathfinder.hpp"
+#include "PathCache.hpp"
+#include "ThreadPool.hpp"
+
+// dostop do zasebnega buildPath() runnerjev (friend v SearchRunner.hpp)
+struct RunnerBenchAccess {
+    template <class Runner>
+    static void buildPath(Runner& runner) { runner.buildPath(); }
+};
+
+namespace {
+
+constexpr std::uint32_t kSeed = 1;
+constexpr double kDensity = 0.25;
+
+const int kSizes[] = {64, 256, 1024, 4096};
+const MapKind kMaps[] = {MapKind::Open, MapKind::Maze, MapKind::Random};
+constexpr int kBatchQueries = 256;
+
+// mreže so drage za izdelavo (4096x4096 labirint), zato jih zgradimo enkrat
+const Grid& cachedGrid(MapKind kind, int size) {
+    static std::map<std::pair<int, int>, Grid> cache;
+    auto key = std::make_pair(static_cast<int>(kind), size);
+    auto it = cache.find(key);
+    if (it == cache.end())
+        it = cache.emplace(key, makeBenchGrid(kind, size, size, kDensity, kSeed)).first;
+    return it->second;
+}
+
+template <class Runner>
+void runToEnd(Runner& runner) {
+    while (!runner.step()) {
+    }
+}
+
+template <class Runner>
+void benchConstruct(benchmark::State& state, MapKind kind, int size) {
+    const Grid& grid = cachedGrid(kind, size);
+    for (auto _ : state) {
+        Runner runner(grid);
+        benchmark::DoNotOptimize(&runner);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size) * size);
+}
+
+template <class Runner>
+void benchStep(benchmark::State& state, MapKind kind, int size) {
+    const Grid& grid = cachedGrid(kind, size);
+    std::int64_t expanded = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Runner runner(grid);
+        state.ResumeTiming();
+
+        runToEnd(runner);
+
+        expanded += runner.getVisitedCount();
+        benchmark::DoNotOptimize(runner.getPathLength());
+    }
+    // items/s = razširjena vozlišča na sekundo
+    state.SetItemsProcessed(expanded);
+}
+
+template <class Runner>
+void benchBuildPath(benchmark::State& state, MapKind kind, int size) {
+    const Grid& grid = cachedGrid(kind, size);
+    Runner runner(grid);
+    runToEnd(runner);
+    if (!runner.hasPath()) {
+        state.SkipWithError("no path on this map");
+        return;
+    }
+    for (auto _ : state) {
+        RunnerBenchAccess::buildPath(runner);
+        benchmark::DoNotOptimize(runner.getPathLength());
+    }
+    state.SetItemsProcessed(state.iterations() * runner.getPathLength());
+}
+
+void benchGenerateMaze(benchmark::State& state, MazeAlgorithm algorithm, int size) {
+    Grid grid(size, size, 1);
+    for (auto _ : state) {
+        grid.generateMaze(kSeed, algorithm);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size) * size);
+}
+
+void benchGenerateMazeTiled(benchmark::State& state, MazeAlgorithm algorithm, int size) {
+    Grid grid(size, size, 1);
+    ThreadPool pool;
+    for (auto _ : state) {
+        grid.generateMaze(kSeed, algorithm, pool);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size) * size);
+}
+
+void benchFlowField(benchmark::State& state, MapKind kind, int size) {
+    const Grid& grid = cachedGrid(kind, size);
+    const std::vector<sf::Vector2i> goals{*grid.getEnd()};
+    FlowField field(grid);
+    for (auto _ : state) {
+        field.build(goals);
+        benchmark::DoNotOptimize(field.distance(0, 0));
+    }
+    state.counters["threads"] = field.threadCount();
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size) * size);
+}
+
+void benchFlowFieldUpdate(benchmark::State& state, MapKind kind, int size) {
+    // kopija, ker update() spreminja mrežo
+    Grid grid = cachedGrid(kind, size);
+    const std::vector<sf::Vector2i> goals{*grid.getEnd()};
+    const std::vector<sf::Vector2i> changed{{size / 2, size / 2}};
+    FlowField field(grid);
+    field.build(goals);
+
+    std::int64_t tiles = 0;
+    for (auto _ : state) {
+        grid.setWall(size / 2, size / 2, !grid.isWall(size / 2, size / 2));
+        field.update(changed);
+        tiles += field.tilesProcessed();
+    }
+    state.counters["tiles"] = benchmark::Counter(static_cast<double>(tiles),
+                                                 benchmark::Counter::kAvgIterations);
+}
+
+void benchReplan(benchmark::State& state, MapKind kind, int size) {
+    // kopija, ker meritev spreminja mrežo
+    Grid grid = cachedGrid(kind, size);
+    DStarLiteRunner runner(grid);
+    runToEnd(runner);
+    if (!runner.hasPath()) {
+        state.SkipWithError("no path");
+        return;
+    }
+
+    // preklapljamo celico na sredini prvotne poti (ne start in ne cilj)
+    const auto& path = runner.getPath();
+    const sf::Vector2i cell = path[path.size() / 2];
+
+    std::int64_t expanded = 0;
+    for (auto _ : state) {
+        grid.setWall(cell.x, cell.y, !grid.isWall(cell.x, cell.y));
+        runner.gridChanged(cell);
+        runToEnd(runner);
+        expanded += runner.getVisitedCount();
+    }
+    state.counters["expanded"] = benchmark::Counter(static_cast<double>(expanded),
+                                                    benchmark::Counter::kAvgIterations);
+}
+
+void benchConnected(benchmark::State& state, MapKind kind, int size) {
+    // kopija, ker meritev spreminja mrežo; vsaka iteracija je urejanje + poizvedba
+    Grid grid = cachedGrid(kind, size);
+    const sf::Vector2i start = *grid.getStart();
+    const sf::Vector2i end = *grid.getEnd();
+    const sf::Vector2i cell{size / 2, size / 2};
+    for (auto _ : state) {
+        grid.setWall(cell.x, cell.y, !grid.isWall(cell.x, cell.y));
+        benchmark::DoNotOptimize(grid.connected(start, end));
+    }
+}
+
+void benchHpaUpdate(benchmark::State& state, MapKind kind, int size) {
+    // kopija, ker meritev spreminja mrežo
+    Grid grid = cachedGrid(kind, size);
+    const std::vector<sf::Vector2i> changed{{size / 2, size / 2}};
+    HierarchicalGraph graph(grid);
+
+    std::int64_t clusters = 0;
+    for (auto _ : state) {
+        grid.setWall(size / 2, size / 2, !grid.isWall(size / 2, size / 2));
+        graph.update(changed);
+        clusters += graph.clustersRebuilt();
+    }
+    state.counters["clusters"] = benchmark::Counter(static_cast<double>(clusters),
+                                                    benchmark::Counter::kAvgIterations);
+}
+
+// bazen vseh jeder, skupen za vse paketne meritve
+ThreadPool& benchPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+template <class Runner>
+void benchBatch(benchmark::State& state, MapKind kind, int size) {
+    const Grid& grid = cachedGrid(kind, size);
+    const std::vector<PathQuery> queries = makeBenchQueries(grid, kBatchQueries, kSeed);
+    BatchPathfinder<Runner> batch(grid, benchPool());
+    for (auto _ : state) {
+        auto results = batch.run(queries);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["threads"] = benchPool().size();
+    state.SetItemsProcessed(state.iterations() * kBatchQueries);
+}
+
+void benchPathCacheHit(benchmark::State& state, MapKind kind, int size) {
+    const Grid& grid = cachedGrid(kind, size);
+    const std::vector<PathQuery> queries = makeBenchQueries(grid, kBatchQueries, kSeed);
+    PathCache cache(grid, kBatchQueries);
+    AStarRunner runner(grid);
+    for (const PathQuery& q : queries)
+        cache.findPath(runner, q.start, q.goal, 0);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const PathQuery& q = queries[i++ % queries.size()];
+        benchmark::DoNotOptimize(cache.find(q.start, q.goal, 0));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Runner>
+void registerRunner(const std::string& algo) {
+    for (MapKind kind : kMaps) {
+        for (int size : kSizes) {
+            const std::string suffix =
+                algo + "/" + mapKindName(kind) + "/" + std::to_string(size);
+
+            benchmark::RegisterBenchmark(("construct/" + suffix).c_str(),
+                                         benchConstruct<Runner>, kind, size)
+                ->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("step/" + suffix).c_str(),
+                                         benchStep<Runner>, kind, size)
+                ->Unit(benchmark::kMillisecond);
+            benchmark::RegisterBenchmark(("buildPath/" + suffix).c_str(),
+                                         benchBuildPath<Runner>, kind, size)
+                ->Unit(benchmark::kMicrosecond);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    registerRunner<BFSRunner>("bfs");
+    registerRunner<DijkstraRunner>("dijkstra");
+    registerRunner<AStarRunner>("astar");
+    registerRunner<DijkstraBucketRunner>("dijkstra-bucket");
+    registerRunner<AStarBucketRunner>("astar-bucket");
+    registerRunner<DijkstraRadixRunner>("dijkstra-radix");
+    registerRunner<AStarRadixRunner>("astar-radix");
+    registerRunner<JPSRunner>("jps");
+    registerRunner<JPSPlusRunner>("jps-plus");
+    registerRunner<BidirectionalBFSRunner>("bfs-bidir");
+    registerRunner<BidirectionalAStarRunner>("astar-bidir");
+    registerRunner<FloodFillRunner>("bfs-bitset");
+    registerRunner<DStarLiteRunner>("dstar-lite");
+    registerRunner<HPAStarRunner>("hpa");
+
+    for (MapKind kind : kMaps) {
+        for (int size : kSizes) {
+            const std::string suffix = std::string(mapKindName(kind)) + "/" + std::to_string(size);
+            benchmark::RegisterBenchmark(("flowField/" + suffix).c_str(),
+                                         benchFlowField, kind, size)
+                ->Unit(benchmark::kMillisecond);
+            benchmark::RegisterBenchmark(("flowFieldUpdate/" + suffix).c_str(),
+                                         benchFlowFieldUpdate, kind, size)
+                ->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("replan/dstar-lite/" + suffix).c_str(),
+                                         benchReplan, kind, size)
+                ->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("connected/" + suffix).c_str(),
+                                         benchConnected, kind, size)
+                ->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("hpaUpdate/" + suffix).c_str(),
+                                         benchHpaUpdate, kind, size)
+                ->Unit(benchmark::kMicrosecond);
+            benchmark::RegisterBenchmark(("pathCache/hit/" + suffix).c_str(),
+                                         benchPathCacheHit, kind, size)
+                ->Unit(benchmark::kNanosecond);
+        }
+    }
+
+    // velikost 4096 bi z vsemi poizvedbami trajala predolgo
+    for (MapKind kind : kMaps) {
+        for (int size : {64, 256, 1024}) {
+            const std::string suffix = std::string(mapKindName(kind)) + "/" + std::to_string(size);
+            benchmark::RegisterBenchmark(("batch/astar/" + suffix).c_str(),
+                                         benchBatch<AStarRunner>, kind, size)
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+            benchmark::RegisterBenchmark(("batch/jps/" + suffix).c_str(),
+                                         benchBatch<JPSRunner>, kind, size)
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+        }
+    }
+
+    for (MazeAlgorithm algorithm : {MazeAlgorithm::Backtracker, MazeAlgorithm::Eller,
+                                    MazeAlgorithm::Kruskal, MazeAlgorithm::Wilson}) {
+        for (int size : kSizes) {
+            // backtracker obdrži staro ime
+            const std::string prefix = algorithm == MazeAlgorithm::Backtracker
+                ? "generateMaze/"
+                : "generateMaze/" + std::string(mazeAlgorithmName(algorithm)) + "/";
+            benchmark::RegisterBenchmark((prefix + std::to_string(size)).c_str(),
+                                         benchGenerateMaze, algorithm, size)
+                ->Unit(benchmark::kMillisecond);
+            benchmark::RegisterBenchmark(("generateMazeTiled/" +
+                                          std::string(mazeAlgorithmName(algorithm)) + "/" +
+                                          std::to_string(size)).c_str(),
+                                         benchGenerateMazeTiled, algorithm, size)
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,685 @@
+// Harness za scenarije MovingAI (.scen): vsak scenarij požene skozi izbrane
+// runnerje, preveri pot (sosednje proste celice od starta do cilja) in njeno
+// ceno ter izpiše prepustnost, percentile latence in razširjena vozlišča po
+// (algoritem, bucket) kot CSV na stdout.
+//
+// .scen podaja 8-sosedsko (oktilno) optimalno dolžino. Za 4-sosedske
+// runnerje je referenca cena najkrajše 4-sosedske poti, ki jo harness
+// izračuna z lastnim BFS; optimalLength iz datoteke služi kot preverba
+// scenarija (referenca ne sme biti krajša, cilj mora biti dosegljiv).
+// 8-sosedski runnerji (dijkstra8-exact, astar8-exact; brez rezanja vogalov,
+// cena 408 / 577 na raven / diagonalni korak) se primerjajo z lastnim
+// oktilnim Dijkstro, ki mora po deljenju s 408 ustrezati optimalLength.
+//
+// Z --baseline primerja rezultate s prejšnjim CSV: napačna pot, slabša
+// optimalnost, več razširjenih vozlišč ali (v skupni vrstici algoritma)
+// počasnejši p50 / manjša prepustnost nad --tolerance podere zagon z
+// izpisom razlik na stderr in izhodno kodo 1.
+//
+// Primer:
+//   PathfindingScenarios --map-dir maps --algo astar,jps scen/den520d.map.scen > now.csv
+//   PathfindingScenarios --baseline now.csv scen/den520d.map.scen
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Grid.hpp"
+#include "GridFile.hpp"
+#include "MovingAIScenario.hpp"
+#include "BFSRunner.hpp"
+#include "DijkstraRunner.hpp"
+#include "AStarRunner.hpp"
+#include "JPSRunner.hpp"
+#include "BidirectionalRunner.hpp"
+#include "FloodFillRunner.hpp"
+#include "DStarLiteRunner.hpp"
+#include "HPAStarRunner.hpp"
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct ScenarioOptions {
+    std::vector<std::string> scenFiles;
+    std::string mapDir;     // prazno = mapa .scen datoteke
+    std::string algos = "bfs,dijkstra,astar,dijkstra-bucket,astar-bucket,"
+                        "dijkstra-radix,astar-radix,jps,jps-plus,bfs-bidir,astar-bidir,bfs-bitset,"
+                        "dstar-lite,hpa,dijkstra8-exact,astar8-exact";
+    int repeat = 1;         // latenca scenarija je najmanjša izmed ponovitev
+    std::string baseline;   // CSV prejšnjega zagona
+    double tolerance = 0.15; // dovoljeno poslabšanje časa (delež)
+    int maxFailures = 10;   // izpisanih napačnih scenarijev na algoritem
+};
+
+using Clock = std::chrono::steady_clock;
+
+// rezultat enega scenarija za en runner
+struct Sample {
+    int bucket = 0;
+    double us = 0.0;
+    int expanded = 0;
+    std::int64_t cost = -1; // -1 = ni poti
+    bool valid = false; // pot je veljavna 4- (oz. 8-) sosedska pot od starta do cilja
+};
+
+// preveri pot in vrne njeno ceno (vstop v celico stane njen teren) ali -1;
+// pri octile so dovoljene tudi diagonale brez rezanja vogalov, korak pa stane
+// teren * OctileExact
+std::int64_t pathCost(const Grid& grid, const std::vector<sf::Vector2i>& path,
+                      sf::Vector2i start, sf::Vector2i goal, bool octile) {
+    if (path.empty() || path.front() != start || path.back() != goal)
+        return -1;
+    std::int64_t cost = 0;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        const sf::Vector2i p = path[i];
+        if (!grid.inBounds(p.x, p.y) || grid.isWall(p.x, p.y))
+            return -1;
+        if (i == 0)
+            continue;
+        const sf::Vector2i d = p - path[i - 1];
+        if (!octile) {
+            if (std::abs(d.x) + std::abs(d.y) != 1)
+                return -1;
+            cost += grid.getCost(p.x, p.y);
+            continue;
+        }
+        if (std::abs(d.x) > 1 || std::abs(d.y) > 1 || d == sf::Vector2i{0, 0})
+            return -1;
+        const bool diagonal = d.x != 0 && d.y != 0;
+        if (diagonal && (grid.isWall(p.x, p.y - d.y) || grid.isWall(p.x - d.x, p.y)))
+            return -1;
+        cost += grid.getCost(p.x, p.y) * (diagonal ? OctileExact::Diagonal : OctileExact::Straight);
+    }
+    return cost;
+}
+
+template <class Runner, class... Args>
+std::vector<Sample> runScenarios(const Grid& grid, const std::vector<const Scenario*>& scenarios,
+                                 int repeat, Args... args) {
+    constexpr bool octile = std::is_same_v<Runner, Dijkstra8ExactRunner> ||
+                            std::is_same_v<Runner, AStar8ExactRunner>;
+    Runner runner(grid, args...);
+    std::vector<Sample> samples;
+    samples.reserve(scenarios.size());
+    for (const Scenario* s : scenarios) {
+        Sample sample;
+        sample.bucket = s->bucket;
+        sample.us = std::numeric_limits<double>::max();
+        for (int rep = 0; rep < repeat; ++rep) {
+            const auto t0 = Clock::now();
+            runner.reset(s->start, s->goal);
+            while (!runner.step()) {
+            }
+            const auto t1 = Clock::now();
+            sample.us = std::min(sample.us, std::chrono::duration<double, std::micro>(t1 - t0).count());
+        }
+        sample.expanded = runner.getVisitedCount();
+        if (runner.hasPath()) {
+            sample.cost = runner.getPathCost();
+            sample.valid = pathCost(grid, runner.getPath(), s->start, s->goal, octile) == sample.cost;
+        }
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+template <class Runner>
+std::vector<Sample> runPlain(const Grid& grid, const std::vector<const Scenario*>& scenarios, int repeat) {
+    return runScenarios<Runner>(grid, scenarios, repeat);
+}
+
+std::vector<Sample> runJpsPlus(const Grid& grid, const std::vector<const Scenario*>& scenarios, int repeat) {
+    return runScenarios<JPSPlusRunner>(grid, scenarios, repeat,
+                                       std::make_shared<const JumpPointTable>(grid));
+}
+
+std::vector<Sample> runHpa(const Grid& grid, const std::vector<const Scenario*>& scenarios, int repeat) {
+    return runScenarios<HPAStarRunner>(grid, scenarios, repeat,
+                                       std::shared_ptr<const HierarchicalGraph>(
+                                           std::make_shared<HierarchicalGraph>(grid)));
+}
+
+struct AlgoEntry {
+    const char* name;
+    bool optimal; // mora najti najcenejšo pot (HPA* je le skoraj optimalen)
+    bool octile;  // 8-sosedski, referenca je ReferenceOctile
+    std::vector<Sample> (*run)(const Grid&, const std::vector<const Scenario*>&, int);
+};
+
+const AlgoEntry kAlgos[] = {
+    {"bfs", true, false, &runPlain<BFSRunner>},
+    {"dijkstra", true, false, &runPlain<DijkstraRunner>},
+    {"astar", true, false, &runPlain<AStarRunner>},
+    {"dijkstra-bucket", true, false, &runPlain<DijkstraBucketRunner>},
+    {"astar-bucket", true, false, &runPlain<AStarBucketRunner>},
+    {"dijkstra-radix", true, false, &runPlain<DijkstraRadixRunner>},
+    {"astar-radix", true, false, &runPlain<AStarRadixRunner>},
+    {"jps", true, false, &runPlain<JPSRunner>},
+    {"jps-plus", true, false, &runJpsPlus},
+    {"bfs-bidir", true, false, &runPlain<BidirectionalBFSRunner>},
+    {"astar-bidir", true, false, &runPlain<BidirectionalAStarRunner>},
+    {"bfs-bitset", true, false, &runPlain<FloodFillRunner>},
+    {"dstar-lite", true, false, &runPlain<DStarLiteRunner>},
+    {"hpa", false, false, &runHpa},
+    {"dijkstra8-exact", true, true, &runPlain<Dijkstra8ExactRunner>},
+    {"astar8-exact", true, true, &runPlain<AStar8ExactRunner>},
+};
+
+// Referenčna cena: BFS po 4-sosedih (mape MovingAI imajo enotne cene).
+// Žig obiskov se ne briše med poizvedbami.
+class ReferenceBFS {
+public:
+    explicit ReferenceBFS(const Grid& grid)
+        : m_grid(&grid), m_seen(grid.cellCount(), 0), m_dist(grid.cellCount(), 0) {}
+
+    int distance(sf::Vector2i start, sf::Vector2i goal) {
+        const Grid& grid = *m_grid;
+        if (!grid.inBounds(start.x, start.y) || !grid.inBounds(goal.x, goal.y) ||
+            grid.isWall(start.x, start.y) || grid.isWall(goal.x, goal.y))
+            return -1;
+        ++m_stamp;
+        const int source = grid.cellIndex(start.x, start.y);
+        const int target = grid.cellIndex(goal.x, goal.y);
+        const int offsets[4] = {1, -1, grid.paddedCols(), -grid.paddedCols()};
+        m_queue.clear();
+        m_queue.push_back(source);
+        m_seen[source] = m_stamp;
+        m_dist[source] = 0;
+        for (std::size_t head = 0; head < m_queue.size(); ++head) {
+            const int cell = m_queue[head];
+            if (cell == target)
+                return m_dist[cell];
+            const sf::Vector2i p = grid.cellPos(cell);
+            const unsigned open = grid.openNeighbors4(p.x, p.y);
+            for (int i = 0; i < 4; ++i) {
+                const int next = cell + offsets[i];
+                if (!(open & (1u << i)) || m_seen[next] == m_stamp)
+                    continue;
+                m_seen[next] = m_stamp;
+                m_dist[next] = m_dist[cell] + 1;
+                m_queue.push_back(next);
+            }
+        }
+        return -1;
+    }
+
+private:
+    const Grid* m_grid;
+    std::vector<std::uint32_t> m_seen;
+    std::vector<int> m_dist;
+    std::vector<int> m_queue;
+    std::uint32_t m_stamp = 0;
+};
+
+// Referenčna cena 8-sosedske poti brez rezanja vogalov v enotah OctileExact
+// (Dijkstra s kopico; prebere samo isWall, neodvisno od mask mreže).
+class ReferenceOctile {
+public:
+    explicit ReferenceOctile(const Grid& grid)
+        : m_grid(&grid), m_seen(grid.cellCount(), 0), m_dist(grid.cellCount(), 0) {}
+
+    std::int64_t distance(sf::Vector2i start, sf::Vector2i goal) {
+        const Grid& grid = *m_grid;
+        if (!grid.inBounds(start.x, start.y) || !grid.inBounds(goal.x, goal.y) ||
+            grid.isWall(start.x, start.y) || grid.isWall(goal.x, goal.y))
+            return -1;
+        ++m_stamp;
+        auto free = [&](int x, int y) { return grid.inBounds(x, y) && !grid.isWall(x, y); };
+        const int source = grid.cellIndex(start.x, start.y);
+        const int target = grid.cellIndex(goal.x, goal.y);
+        using Entry = std::pair<std::int64_t, int>; // (razdalja, celica)
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+        m_seen[source] = m_stamp;
+        m_dist[source] = 0;
+        open.push({0, source});
+        while (!open.empty()) {
+            const auto [d, cell] = open.top();
+            open.pop();
+            if (d != m_dist[cell])
+                continue;
+            if (cell == target)
+                return d;
+            const sf::Vector2i p = grid.cellPos(cell);
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if ((dx == 0 && dy == 0) || !free(p.x + dx, p.y + dy))
+                        continue;
+                    const bool diagonal = dx != 0 && dy != 0;
+                    if (diagonal && (!free(p.x + dx, p.y) || !free(p.x, p.y + dy)))
+                        continue;
+                    const int next = grid.cellIndex(p.x + dx, p.y + dy);
+                    const std::int64_t nd = d + grid.getCost(p.x + dx, p.y + dy) *
+                                                    (diagonal ? OctileExact::Diagonal : OctileExact::Straight);
+                    if (m_seen[next] == m_stamp && m_dist[next] <= nd)
+                        continue;
+                    m_seen[next] = m_stamp;
+                    m_dist[next] = nd;
+                    open.push({nd, next});
+                }
+            }
+        }
+        return -1;
+    }
+
+private:
+    const Grid* m_grid;
+    std::vector<std::uint32_t> m_seen;
+    std::vector<std::int64_t> m_dist;
+    std::uint32_t m_stamp = 0;
+};
+
+// zbirna vrstica CSV za (algoritem, bucket)
+struct BucketStats {
+    std::string algo;
+    int bucket = 0;
+    int scenarios = 0;
+    int failures = 0;       // ni poti, neveljavna pot ali (pri optimalnih) predraga pot
+    int suboptimal = 0;     // dražje od reference
+    double excess = 0.0;    // povprečno razmerje cena / referenca - 1
+    double queriesPerSec = 0.0;
+    double p50 = 0.0, p90 = 0.0, p99 = 0.0, maxUs = 0.0;
+    double meanExpanded = 0.0;
+};
+
+// bucket skupne vrstice algoritma (v CSV "all")
+constexpr int AllBuckets = -1;
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty())
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    // najbližji rang
+    const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(values.size())));
+    return values[std::clamp<std::size_t>(rank, 1, values.size()) - 1];
+}
+
+BucketStats summarize(const AlgoEntry& entry, int bucket, const std::vector<Sample>& list,
+                       const std::vector<std::int64_t>& ref) {
+    BucketStats s;
+    s.algo = entry.name;
+    s.bucket = bucket;
+    s.scenarios = static_cast<int>(list.size());
+    std::vector<double> latencies;
+    double totalUs = 0.0;
+    double excess = 0.0;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        const Sample& r = list[i];
+        const bool found = r.cost >= 0 && r.valid && r.cost >= ref[i];
+        if (!found || (entry.optimal && r.cost != ref[i]))
+            ++s.failures;
+        if (found && r.cost > ref[i]) {
+            ++s.suboptimal;
+            excess += ref[i] > 0 ? static_cast<double>(r.cost) / ref[i] - 1.0 : 0.0;
+        }
+        latencies.push_back(r.us);
+        totalUs += r.us;
+        s.meanExpanded += r.expanded;
+    }
+    s.excess = excess / s.scenarios;
+    s.meanExpanded /= s.scenarios;
+    s.queriesPerSec = totalUs > 0.0 ? s.scenarios * 1.0e6 / totalUs : 0.0;
+    s.p50 = percentile(latencies, 0.50);
+    s.p90 = percentile(latencies, 0.90);
+    s.p99 = percentile(latencies, 0.99);
+    s.maxUs = percentile(latencies, 1.0);
+    return s;
+}
+
+std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty())
+            out.push_back(item);
+    return out;
+}
+
+void printUsage() {
+    std::cerr <<
+        "Usage: PathfindingScenarios [options] file.scen...\n"
+        "  --map-dir DIR            where to look for the .map files (default: next to the .scen)\n"
+        "  --algo a,b,...           bfs,dijkstra,astar,dijkstra-bucket,astar-bucket,\n"
+        "                           dijkstra-radix,astar-radix,jps,jps-plus,\n"
+        "                           bfs-bidir,astar-bidir,bfs-bitset,dstar-lite,hpa,\n"
+        "                           dijkstra8-exact,astar8-exact\n"
+        "                           (default all)\n"
+        "  --repeat N               runs per scenario, latency is the fastest (default 1)\n"
+        "  --baseline FILE          compare with an earlier CSV; regressions exit with 1\n"
+        "  --tolerance F            allowed slowdown against the baseline (default 0.15)\n";
+}
+
+bool parseArgs(int argc, char** argv, ScenarioOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string key = argv[i];
+        if (key == "--help" || key == "-h")
+            return false;
+        if (!key.starts_with("--")) {
+            opt.scenFiles.push_back(key);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << key << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+
+        if (key == "--map-dir") {
+            opt.mapDir = value;
+        } else if (key == "--algo") {
+            opt.algos = value;
+        } else if (key == "--repeat") {
+            opt.repeat = std::atoi(value.c_str());
+        } else if (key == "--baseline") {
+            opt.baseline = value;
+        } else if (key == "--tolerance") {
+            opt.tolerance = std::atof(value.c_str());
+        } else {
+            std::cerr << "Unknown option: " << key << "\n";
+            return false;
+        }
+    }
+
+    if (opt.scenFiles.empty()) {
+        std::cerr << "No .scen files given\n";
+        return false;
+    }
+    if (opt.repeat <= 0 || opt.tolerance < 0.0) {
+        std::cerr << "repeat must be positive and tolerance not negative\n";
+        return false;
+    }
+    return true;
+}
+
+// .map iz stolpca scenarija: v --map-dir, ob .scen ali pot, kot je zapisana
+std::optional<fs::path> resolveMap(const ScenarioOptions& opt, const fs::path& scenFile,
+                                   const std::string& map) {
+    const fs::path column(map);
+    std::vector<fs::path> candidates;
+    if (!opt.mapDir.empty()) {
+        candidates.push_back(fs::path(opt.mapDir) / column);
+        candidates.push_back(fs::path(opt.mapDir) / column.filename());
+    }
+    candidates.push_back(scenFile.parent_path() / column);
+    candidates.push_back(scenFile.parent_path() / column.filename());
+    candidates.push_back(column);
+    for (const fs::path& p : candidates)
+        if (fs::is_regular_file(p))
+            return p;
+    return std::nullopt;
+}
+
+void printCsv(const std::vector<BucketStats>& stats) {
+    std::cout << "algo,bucket,scenarios,failures,suboptimal,excess,queries_per_s,"
+                 "p50_us,p90_us,p99_us,max_us,mean_expanded\n";
+    std::cout << std::fixed;
+    for (const BucketStats& s : stats) {
+        std::cout << s.algo << ',';
+        if (s.bucket == AllBuckets)
+            std::cout << "all";
+        else
+            std::cout << s.bucket;
+        std::cout << ',' << s.scenarios << ',' << s.failures << ','
+                  << s.suboptimal << ',' << std::setprecision(6) << s.excess << ','
+                  << std::setprecision(1) << s.queriesPerSec << ','
+                  << std::setprecision(3) << s.p50 << ',' << s.p90 << ',' << s.p99 << ','
+                  << s.maxUs << ',' << std::setprecision(1) << s.meanExpanded << '\n';
+    }
+}
+
+std::optional<std::vector<BucketStats>> readCsv(const std::string& path, std::string* error) {
+    std::ifstream in(path);
+    if (!in) {
+        *error = "cannot open " + path;
+        return std::nullopt;
+    }
+    std::vector<BucketStats> out;
+    std::string line;
+    std::getline(in, line); // glava
+    while (std::getline(in, line)) {
+        if (line.empty())
+            continue;
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        BucketStats s;
+        std::string bucket;
+        if (!(fields >> s.algo >> bucket >> s.scenarios >> s.failures >> s.suboptimal >> s.excess
+                     >> s.queriesPerSec >> s.p50 >> s.p90 >> s.p99 >> s.maxUs >> s.meanExpanded)) {
+            *error = path + ": malformed line: " + line;
+            return std::nullopt;
+        }
+        s.bucket = bucket == "all" ? AllBuckets : std::atoi(bucket.c_str());
+        out.push_back(s);
+    }
+    return out;
+}
+
+// Izpiše razlike, ki so regresija, in vrne njihovo število. Pravilnost in
+// razširjena vozlišča (deterministična) se primerjajo po bucketih, čas pa
+// samo v vrstici "all", ker ima bucket premalo scenarijev za stabilen p50.
+int compareWithBaseline(const std::vector<BucketStats>& now, const std::vector<BucketStats>& base,
+                        double tolerance) {
+    std::map<std::pair<std::string, int>, const BucketStats*> byKey;
+    for (const BucketStats& b : base)
+        byKey[{b.algo, b.bucket}] = &b;
+
+    int regressions = 0;
+    auto report = [&](const BucketStats& s, const std::string& what, double before, double after,
+                      const char* limit) {
+        std::cerr << "REGRESSION " << s.algo << " bucket "
+                  << (s.bucket == AllBuckets ? std::string("all") : std::to_string(s.bucket)) << ": " << what << ' '
+                  << before << " -> " << after;
+        if (before > 0.0)
+            std::cerr << " (" << std::showpos << std::setprecision(1)
+                      << (after / before - 1.0) * 100.0 << '%' << std::noshowpos << ')';
+        std::cerr << ", limit " << limit << '\n';
+        ++regressions;
+    };
+
+    std::cerr << std::fixed << std::setprecision(3);
+    std::ostringstream limitText;
+    limitText << std::fixed << std::setprecision(1) << '+' << tolerance * 100.0 << '%';
+    const std::string limit = limitText.str();
+
+    for (const BucketStats& s : now) {
+        auto it = byKey.find({s.algo, s.bucket});
+        if (it == byKey.end())
+            continue;
+        const BucketStats& b = *it->second;
+        if (s.failures > b.failures)
+            report(s, "failures", b.failures, s.failures, "no increase");
+        if (s.suboptimal > b.suboptimal)
+            report(s, "suboptimal", b.suboptimal, s.suboptimal, "no increase");
+        if (s.excess > b.excess + 1e-6)
+            report(s, "excess", b.excess, s.excess, "no increase");
+        if (s.meanExpanded > b.meanExpanded * 1.01)
+            report(s, "mean_expanded", b.meanExpanded, s.meanExpanded, "+1.0%");
+        if (s.bucket != AllBuckets)
+            continue;
+        if (s.p50 > b.p50 * (1.0 + tolerance))
+            report(s, "p50_us", b.p50, s.p50, limit.c_str());
+        if (s.queriesPerSec * (1.0 + tolerance) < b.queriesPerSec)
+            report(s, "queries_per_s", b.queriesPerSec, s.queriesPerSec, limit.c_str());
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ScenarioOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage();
+        return 2;
+    }
+
+    std::vector<const AlgoEntry*> selected;
+    for (const auto& name : splitList(opt.algos)) {
+        const AlgoEntry* found = nullptr;
+        for (const auto& entry : kAlgos)
+            if (name == entry.name)
+                found = &entry;
+        if (!found) {
+            std::cerr << "Unknown algorithm: " << name << "\n";
+            printUsage();
+            return 2;
+        }
+        selected.push_back(found);
+    }
+
+    // scenariji po mapah: vsaka mapa se naloži enkrat
+    std::vector<Scenario> all;
+    std::map<fs::path, std::vector<std::size_t>> byMap;
+    for (const std::string& file : opt.scenFiles) {
+        std::string error;
+        auto scenarios = loadScenarios(file, &error);
+        if (!scenarios) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+        for (Scenario& s : *scenarios) {
+            auto map = resolveMap(opt, file, s.map);
+            if (!map) {
+                std::cerr << file << ": map not found: " << s.map << "\n";
+                return 2;
+            }
+            byMap[*map].push_back(all.size());
+            all.push_back(std::move(s));
+        }
+    }
+
+    bool scenarioErrors = false;
+    std::map<std::pair<int, int>, std::vector<Sample>> samples; // (algo, bucket)
+    std::map<std::pair<int, int>, std::vector<std::int64_t>> references;  // ista razporeditev kot samples
+    int failuresShown[std::size(kAlgos)] = {};
+
+    for (const auto& [mapPath, indices] : byMap) {
+        std::string error;
+        std::optional<Grid> grid = loadGrid(mapPath.string(), 1, &error);
+        if (!grid) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+
+        // oktilna referenca samo, če je izbran kakšen 8-sosedski runner
+        const bool needOctile = std::any_of(selected.begin(), selected.end(),
+                                            [](const AlgoEntry* e) { return e->octile; });
+
+        std::vector<const Scenario*> scenarios;
+        std::vector<std::int64_t> reference;
+        std::vector<std::int64_t> octileReference;
+        ReferenceBFS bfs(*grid);
+        ReferenceOctile octile(*grid);
+        for (std::size_t i : indices) {
+            const Scenario& s = all[i];
+            if (s.mapWidth != grid->getCols() || s.mapHeight != grid->getRows()) {
+                std::cerr << "SCENARIO " << mapPath.string() << ": size " << s.mapWidth << 'x'
+                          << s.mapHeight << " does not match the map (" << grid->getCols() << 'x'
+                          << grid->getRows() << ")\n";
+                scenarioErrors = true;
+                break;
+            }
+            // 4-sosedska pot ni nikoli krajša od 8-sosedske; brez rezanja vogalov
+            // je dosegljivost enaka
+            const int d = bfs.distance(s.start, s.goal);
+            if (d < 0 || d + 1e-4 < s.optimalLength) {
+                std::cerr << "SCENARIO " << mapPath.string() << " (" << s.start.x << ',' << s.start.y
+                          << ")->(" << s.goal.x << ',' << s.goal.y << "): reference "
+                          << d << ", scenario optimal " << s.optimalLength << "\n";
+                scenarioErrors = true;
+                continue;
+            }
+            // 577 / 408 se od sqrt(2) razlikuje za 2e-6, optimalLength je zaokrožen
+            const std::int64_t o = needOctile ? octile.distance(s.start, s.goal) : 0;
+            if (needOctile && std::abs(o / double(OctileExact::Straight) - s.optimalLength) >
+                                  1e-5 * s.optimalLength + 1e-3) {
+                std::cerr << "SCENARIO " << mapPath.string() << " (" << s.start.x << ',' << s.start.y
+                          << ")->(" << s.goal.x << ',' << s.goal.y << "): octile reference "
+                          << o / double(OctileExact::Straight) << ", scenario optimal "
+                          << s.optimalLength << "\n";
+                scenarioErrors = true;
+                continue;
+            }
+            scenarios.push_back(&s);
+            reference.push_back(d);
+            octileReference.push_back(o);
+        }
+
+        for (const AlgoEntry* entry : selected) {
+            const int algo = static_cast<int>(entry - kAlgos);
+            const std::vector<Sample> result = entry->run(*grid, scenarios, opt.repeat);
+            const std::vector<std::int64_t>& expected = entry->octile ? octileReference : reference;
+            for (std::size_t i = 0; i < result.size(); ++i) {
+                const Sample& r = result[i];
+                const Scenario& s = *scenarios[i];
+                const bool wrong = r.cost < 0 || !r.valid || r.cost < expected[i] ||
+                                   (entry->optimal && r.cost != expected[i]);
+                if (wrong && failuresShown[algo]++ < opt.maxFailures) {
+                    std::cerr << "FAIL " << entry->name << ' ' << mapPath.filename().string()
+                              << " bucket " << s.bucket << " (" << s.start.x << ',' << s.start.y
+                              << ")->(" << s.goal.x << ',' << s.goal.y << "): "
+                              << (r.cost < 0 ? "no path" : !r.valid ? "invalid path" : "cost")
+                              << ' ' << r.cost << ", expected " << expected[i] << "\n";
+                }
+                samples[{algo, s.bucket}].push_back(r);
+                references[{algo, s.bucket}].push_back(expected[i]);
+            }
+        }
+    }
+
+    // vrstice po bucketih in na koncu vsakega algoritma skupna vrstica "all"
+    std::vector<BucketStats> stats;
+    int failures = 0;
+    for (std::size_t algo = 0; algo < std::size(kAlgos); ++algo) {
+        std::vector<Sample> allSamples;
+        std::vector<std::int64_t> allReferences;
+        for (const auto& [key, list] : samples) {
+            if (key.first != static_cast<int>(algo))
+                continue;
+            const std::vector<std::int64_t>& ref = references[key];
+            stats.push_back(summarize(kAlgos[algo], key.second, list, ref));
+            failures += stats.back().failures;
+            allSamples.insert(allSamples.end(), list.begin(), list.end());
+            allReferences.insert(allReferences.end(), ref.begin(), ref.end());
+        }
+        if (!allSamples.empty())
+            stats.push_back(summarize(kAlgos[algo], AllBuckets, allSamples, allReferences));
+    }
+    printCsv(stats);
+
+    int regressions = 0;
+    if (!opt.baseline.empty()) {
+        std::string error;
+        auto base = readCsv(opt.baseline, &error);
+        if (!base) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+        regressions = compareWithBaseline(stats, *base, opt.tolerance);
+    }
+
+    if (failures > 0 || regressions > 0 || scenarioErrors) {
+        std::cerr << failures << " wrong paths, " << regressions << " regressions"
+                  << (scenarioErrors ? ", invalid scenarios" : "") << "\n";
+        return 1;
+    }
+    return 0;
+}